@@ -60,11 +60,18 @@ private:
   std::deque<xju::ip::TCPSocket const*> closed_;
 };
 
-// handle request from out-of-session client
-xju::http::Response login(xju::http::Request const& request,
-                          Sessions& sessions) throw(
-                            Shutdown,
-                            xju::Exception)
+// handle request from out-of-session client, sending response on o,
+// which writes to "to"
+// - login resources are sent directly to "to" so that their content
+//   is not copied through a Response (see FileResources::send)
+void login(xju::http::Request const& request,
+           Resources const& loginResources,
+           Sessions& sessions,
+           std::ostream& o,
+           xju::io::OStream& to,
+           std::chrono::steady_clock::time_point const& deadline) throw(
+             Shutdown,
+             xju::Exception)
 {
   try{
     if (request.requestLine.m_=="POST"&&
@@ -76,22 +83,28 @@ xju::http::Response login(xju::http::Request const& request,
       Sessions::Ref session(sessions.newSession(
                               vars.get("user"),
                               vars.get("password")));
-      return xju::http::redirect(
-        {xju::uri::Segment("")},
-        xju::http::setCookie("WEBAPPSESSION",session.id_));
+      xju::http::encodeResponse(
+        o,
+        xju::http::redirect(
+          {xju::uri::Segment("")},
+          xju::http::setCookie("WEBAPPSESSION",session.id_)));
+      return;
     }
-    return loginResources.get(request.requestLine.t_.path);
+    o.flush();
+    loginResources.send(request.requestLine.t_.path,to,deadline);
   }
   catch(AuthenticationFailed const& e){
     logInformation(readableRepr(e),XJU_TRACED);
     xju::sleepFor(std::chrono::seconds(5));
-    return xju::http::Response(
-      xju::http::StatusLine(
-        SUPPORTED_HTTP_VERSION,
-        xju::http::StatusCode(403), //Forbidden
-        xju::http::ReasonPhrase("Authentication failed for user "+e.user_)),
-      {},
-      {});
+    xju::http::encodeResponse(
+      o,
+      xju::http::Response(
+        xju::http::StatusLine(
+          SUPPORTED_HTTP_VERSION,
+          xju::http::StatusCode(403), //Forbidden
+          xju::http::ReasonPhrase("Authentication failed for user "+e.user_)),
+        {},
+        {}));
   }
 }
 
@@ -125,7 +138,7 @@ private:
     try{
       TLSSocket s(s_,crypto_,false,xju::steadyNow()+handshakeTimeout_);
       xju::io::istream i(s);
-      xju::io::ostream o(s);
+      xju::io::ostream o(*s.output_);
       while(true){
         //REVISIT: use select here to implement connection idle timeout
         //         but only if i is empty
@@ -169,11 +182,12 @@ private:
         }
         Cookies const cookies(request.headers_);
         auto sessionId(cookies.get("WEBAPPSESSION",""));
-        xju::http::encodeResponse(
-          o,
-          (!sessionId.size()?
-           login(request,loginResources_,sessions_):
-           sessions.get(sessionId).handle(request)));
+        if (!sessionId.size()){
+          login(request,loginResources_,sessions_,o,*s.output_,deadline);
+        }
+        else{
+          xju::http::encodeResponse(o,sessions.get(sessionId).handle(request));
+        }
         o.flush();
       }
     }
@@ -230,18 +244,17 @@ int main(int argc, char* argv[])
                      xju::steadyEternity).first.size());
       if(r.find(&listener)!=r.end())
       {
-        std::unique_ptr<xju::ip::TCPSocket> s(new xju::ip::TCPSocket(
-                                                listener,
-                                                xju::steadyNow()));
-        xju::ip::TCPSocket const* sp(s.get());
-        xju::Lock l(connsGuard);
-        conns.insert(std::make_pair(sp,std::unique_ptr<Conn> >(
-                                      std::move(s),
-                                      *shutdownServer.first.get(),
-                                      closedConns,
-                                      loginResources,
-                                      sessions)));
-                                       
+        // drain, so a burst of connections costs one select
+        for(auto& s: listener.acceptPending(64)){
+          xju::ip::TCPSocket const* sp(s.get());
+          xju::Lock l(connsGuard);
+          conns.insert(std::make_pair(sp,std::unique_ptr<Conn> >(
+                                        std::move(s),
+                                        *shutdownServer.first.get(),
+                                        closedConns,
+                                        loginResources,
+                                        sessions)));
+        }
       }    
     }
   }
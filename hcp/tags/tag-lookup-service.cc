@@ -19,6 +19,7 @@
 #include "xju/format.hh"
 #include <cxy/ORB.hh>
 #include "hcp/tags/TagLookupService.hh"
+#include <xju/io/InotifyService.hh>
 #include "hcp/tags/Lookup.hh"
 #include "hcp/tags/Lookup.sref.hh"
 #include <xju/file/write.hh>
@@ -88,7 +89,8 @@ int main(int argc, char* argv[])
         std::string const orbEndPoint="giop:tcp:localhost:"+
           xju::format::str(port);
         cxy::ORB<xju::Exception> orb(orbEndPoint);
-        hcp::tags::TagLookupService s(args.second);
+        xju::io::InotifyService inotify;
+        hcp::tags::TagLookupService s(inotify,args.second);
         cxy::sref<hcp::tags::Lookup> sref(orb,"TagLookupService",s);
         auto const tmpFile(xju::path::split(xju::path::str(uriFile)+".new"));
         xju::file::write(tmpFile,
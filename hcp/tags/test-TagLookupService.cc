@@ -16,6 +16,7 @@
 #include <xju/file/rename.hh>
 #include <xju/file/rm.hh>
 #include <xju/file/Mode.hh>
+#include <xju/io/InotifyService.hh>
 
 namespace hcp
 {
@@ -32,7 +33,8 @@ void test1() {
     xju::path::split("tags.new"));
 
   // no files yet
-  TagLookupService x({f1,f2});
+  xju::io::InotifyService inotify;
+  TagLookupService x(inotify,{f1,f2});
   xju::Thread t([&]() { x.run(); },
                 [&]() { x.stop(); });
 
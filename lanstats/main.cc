@@ -7,3 +7,106 @@
 // software for any purpose.  It is provided "as is" without express or
 // implied warranty.
 //
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iostream>
+#include <chrono>
+#include <xju/Exception.hh>
+#include <xju/format.hh>
+#include <xju/stringToUInt.hh>
+#include <cxy/ORB.hh>
+#include <lanstats/lanstats.hh>
+#include <lanstats/lanstats.sref.hh>
+#include <lanstats/Engine.hh>
+#include <lanstats/Service.hh>
+
+char const usage[]=
+  "[-i interface] [-t threads] [-k keys] [-w window-seconds] corba-port\n"
+  "  measures IPv4 traffic seen on interface (default all) by protocol,\n"
+  "  service port and source address, using threads capture threads\n"
+  "  (default 1) each tracking the busiest keys keys (default 65536),\n"
+  "  and provides the lanstats::Server interface - see lanstats.idl -\n"
+  "  giving bytes/s averaged over window-seconds (default 10), at\n"
+  "  corbaloc:iiop:host:corba-port/lanstats\n"
+  "  - needs CAP_NET_RAW (see capabilities(7)), eg run as root";
+
+struct Options
+{
+  std::string interface_;
+  unsigned int threads_;
+  unsigned int keys_;
+  unsigned int window_;
+  unsigned int port_;
+};
+
+Options parseCommandLine(std::vector<std::string> const& x) /*throw(
+  xju::Exception)*/
+{
+  Options result{"",1,65536,10,0};
+  auto i(x.begin());
+  auto const value([&]() -> std::string const& {
+      if (i+1==x.end()){
+        std::ostringstream s;
+        s << *i << " requires a value";
+        throw xju::Exception(s.str(),XJU_TRACED);
+      }
+      return *++i;
+    });
+  for(; i!=x.end() && (*i)[0]=='-'; ++i){
+    if (*i=="-i"){
+      result.interface_=value();
+    }
+    else if (*i=="-t"){
+      result.threads_=xju::stringToUInt(value());
+    }
+    else if (*i=="-k"){
+      result.keys_=xju::stringToUInt(value());
+    }
+    else if (*i=="-w"){
+      result.window_=xju::stringToUInt(value());
+    }
+    else{
+      std::ostringstream s;
+      s << "unknown option " << (*i) << " (only know -i, -t, -k, -w)";
+      throw xju::Exception(s.str(),XJU_TRACED);
+    }
+  }
+  if (i==x.end() || i+1!=x.end()){
+    throw xju::Exception("specify corba-port (only)",XJU_TRACED);
+  }
+  result.port_=xju::stringToUInt(*i);
+  if (!result.threads_ || !result.keys_ || !result.window_){
+    throw xju::Exception("threads, keys and window-seconds must be > 0",
+                         XJU_TRACED);
+  }
+  return result;
+}
+
+int main(int argc, char* argv[])
+{
+  try {
+    if (argc==2 && (argv[1]==std::string("-h")||
+                    argv[1]==std::string("--help"))){
+      std::cerr << "usage: " << argv[0] << " " << usage << std::endl;
+      return 1;
+    }
+    auto const options(
+      parseCommandLine(std::vector<std::string>(argv+1,argv+argc)));
+    cxy::ORB<xju::Exception> orb(
+      "giop:tcp::"+xju::format::str(options.port_));
+    lanstats::Engine engine(options.interface_,
+                            options.threads_,
+                            options.keys_,
+                            std::chrono::seconds(options.window_));
+    lanstats::Service s(engine,std::chrono::seconds(1),std::cerr);
+    cxy::sref<lanstats::Server> sref(orb,"lanstats",s);
+    s.run();
+    return 0;
+  }
+  catch(xju::Exception& e) {
+    e.addContext(xju::format::join(argv,argv+argc," "),XJU_TRACED);
+    std::cerr << "ERROR: " << readableRepr(e) << std::endl;
+    return 1;
+  }
+}
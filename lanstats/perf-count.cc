@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// Single core packets/s of lanstats' per-frame work (classify then
+// count, ie Engine's work per frame less the capture ring) over a mix
+// of TCP and UDP frames from many sources, compared with 1M packets/s;
+// then the same with a million sources (eg a scan) swamping a few
+// heavy hitters, which must still be found.
+//
+#include <lanstats/classify.hh>
+#include <lanstats/RateTable.hh>
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <map>
+#include <set>
+#include <cstdint>
+#include <xju/assert.hh>
+
+namespace lanstats
+{
+
+// IPv4 frame of protocol p from source with ports
+std::vector<uint8_t> frame(uint8_t const p,
+                           uint32_t const source,
+                           uint16_t const sourcePort,
+                           uint16_t const destPort,
+                           size_t const size)
+{
+  std::vector<uint8_t> result(size,0);
+  result[12]=0x08;
+  result[14]=0x45;
+  result[16]=(size-14)>>8;
+  result[17]=(size-14)&0xff;
+  result[22]=64;
+  result[23]=p;
+  uint8_t const dest[]={10,0,0,1};
+  for(int i=0; i!=4; ++i){
+    result[26+i]=source>>(24-8*i);
+    result[30+i]=dest[i];
+  }
+  result[34]=sourcePort>>8;
+  result[35]=sourcePort&0xff;
+  result[36]=destPort>>8;
+  result[37]=destPort&0xff;
+  return result;
+}
+
+// run classify and count over N frames made by f(i), 1us apart,
+// reporting packets/s; returns table's rates at end
+template<class F>
+std::map<Key,Rate> run(std::string const& name, size_t const N, F&& f)
+{
+  std::chrono::steady_clock::time_point const start;
+  RateTable table(65536,10,std::chrono::seconds(1),start);
+  uint64_t bytes(0);
+  auto const t1(std::chrono::steady_clock::now());
+  for(size_t i=0; i!=N; ++i){
+    auto const& x(f(i));
+    auto const k(classify(x.data(),x.size()));
+    table.add(k.value(),x.size(),start+std::chrono::microseconds(i));
+    bytes+=x.size();
+  }
+  auto const t2(std::chrono::steady_clock::now());
+  double const seconds(std::chrono::duration<double>(t2-t1).count());
+  std::map<Key,Rate> result;
+  table.forEach(start+std::chrono::microseconds(N),
+                [&](Key const& k, Rate const& r){
+                  result[k]=r;
+                });
+  double const pps(N/seconds);
+  std::cout << name << ": " << N << " frames, " << result.size()
+            << " keys, " << table.evictions() << " evictions: "
+            << pps/1e6 << "M packets/s ("
+            << bytes*8/seconds/1e9 << " Gbit/s); target 1M packets/s "
+            << (pps>=1e6?"met":"NOT met") << std::endl;
+  return result;
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  size_t const N(20000000);
+  // 4096 frames from 1024 sources to 8 services, sizes 64..1514
+  uint16_t const services[]={22,53,80,123,443,993,3306,8080};
+  std::vector<std::vector<uint8_t> > frames;
+  for(uint32_t i=0; i!=4096; ++i){
+    frames.push_back(frame(i%3?6:17,
+                           0xc0a80000+i%1024,
+                           40000+i,
+                           services[i%8],
+                           64+(i*97)%1451));
+  }
+  auto const mix(
+    run("mix",N,[&](size_t const i) -> std::vector<uint8_t> const& {
+        return frames[i%frames.size()];
+      }));
+  xju::assert_equal(mix.size(),2048U);
+
+  // every other frame from one of 8 heavy hitters, others from any of
+  // 1M sources
+  std::vector<std::vector<uint8_t> > heavy;
+  std::set<Key> heavyKeys;
+  for(uint32_t i=0; i!=8; ++i){
+    heavy.push_back(frame(6,0x0a010000+i,443,50000+i,1500));
+    heavyKeys.insert(
+      classify(heavy.back().data(),heavy.back().size()).value());
+  }
+  auto light(frame(17,0,53,40000,64));
+  auto const swamped(
+    run("1M sources",N,[&](size_t const i) -> std::vector<uint8_t> const& {
+        if (i%2){
+          return heavy[i/2%heavy.size()];
+        }
+        uint32_t const source(0x0b000000+(i/2*2654435761U)%1000000);
+        for(int j=0; j!=4; ++j){
+          light[26+j]=source>>(24-8*j);
+        }
+        return light;
+      }));
+  std::multimap<double,Key> byRate;
+  for(auto const& x: swamped){
+    byRate.insert({x.second.bytes_,x.first});
+  }
+  std::set<Key> top;
+  for(auto i=byRate.rbegin(); top.size()!=heavyKeys.size(); ++i){
+    top.insert(i->second);
+  }
+  xju::assert_equal(top,heavyKeys);
+  return 0;
+}
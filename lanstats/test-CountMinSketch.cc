@@ -0,0 +1,83 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <lanstats/CountMinSketch.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+
+namespace lanstats
+{
+
+// few keys counted exactly
+void test1() {
+  CountMinSketch x(1,1024);
+  xju::assert_equal(x.estimate(1,1),0U);
+  x.add(1,100,1);
+  x.add(2,7,1);
+  x.add(1,50,1);
+  x.add(0xffffffffffffffffULL,3,1);
+  xju::assert_equal(x.estimate(1,1),150U);
+  xju::assert_equal(x.estimate(2,1),7U);
+  xju::assert_equal(x.estimate(0xffffffffffffffffULL,1),3U);
+  xju::assert_equal(x.estimate(3,1),0U);
+}
+
+// amounts leave window
+void test2() {
+  CountMinSketch x(3,64);
+  x.add(1,1,1);
+  x.add(1,10,2);
+  x.add(1,100,3);
+  xju::assert_equal(x.estimate(1,3),111U);
+  x.add(1,1000,4);
+  xju::assert_equal(x.estimate(1,4),1110U);
+  xju::assert_equal(x.estimate(1,5),1100U);
+  xju::assert_equal(x.estimate(1,6),1000U);
+  xju::assert_equal(x.estimate(1,7),0U);
+  // skipped epochs
+  x.add(1,5,9);
+  xju::assert_equal(x.estimate(1,9),5U);
+}
+
+// many keys: never under, rarely over by more than e/width of total
+void test3() {
+  size_t const width(1024);
+  uint64_t const K(100000);
+  CountMinSketch x(2,width);
+  uint64_t total(0);
+  for(uint64_t i=0; i!=K; ++i){
+    x.add(i*2654435761U,i%10+1,1+i%2);
+    total+=i%10+1;
+  }
+  size_t over(0);
+  for(uint64_t i=0; i!=K; ++i){
+    uint64_t const e(x.estimate(i*2654435761U,2));
+    xju::assert_greater_equal(e,i%10+1);
+    if (e-(i%10+1)>2.72*total/width){
+      ++over;
+    }
+  }
+  // at most (1/e)^DEPTH, ie about 2%
+  xju::assert_less(over,K/50);
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <lanstats/Engine.hh>
+
+#include <iostream>
+#include <thread>
+#include <map>
+#include <cmath>
+#include <xju/assert.hh>
+#include <xju/steadyNow.hh>
+#include <xju/ip/UDPSocket.hh>
+#include <xju/ip/v4/Address.hh>
+
+namespace lanstats
+{
+
+// rates of loopback datagrams of several flows over two threads
+void test1() {
+  // window long enough that rates are averaged since engine start
+  auto const t0(xju::steadyNow());
+  Engine engine("lo",2,1000,std::chrono::seconds(20),4U<<20);
+  auto const t1(xju::steadyNow());
+  xju::ip::UDPSocket receiver;
+  std::vector<std::unique_ptr<xju::ip::UDPSocket> > senders;
+  for(int i=0; i!=8; ++i){
+    senders.push_back(
+      std::unique_ptr<xju::ip::UDPSocket>(new xju::ip::UDPSocket));
+  }
+  size_t const N(500);
+  char const payload[100]={0};
+  for(size_t i=0; i!=N; ++i){
+    for(auto& s: senders){
+      s->sendTo({xju::ip::v4::Address("127.0.0.1"),receiver.port()},
+                payload,sizeof(payload),
+                xju::steadyNow()+std::chrono::seconds(1));
+      char x[sizeof(payload)];
+      receiver.receive(x,sizeof(x),
+                       xju::steadyNow()+std::chrono::seconds(1));
+    }
+  }
+  // frame is ethernet + IP + UDP headers + payload
+  uint64_t const frameSize(14+20+8+sizeof(payload));
+  // note senders with ports above receiver's share its key
+  std::map<Key,uint64_t> expected;
+  for(auto& s: senders){
+    expected[Key{xju::ip::Protocol(17),
+                 std::min(s->port(),receiver.port()),
+                 xju::ip::v4::Address("127.0.0.1")}]+=N;
+  }
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  while(true){
+    auto const x(engine.snapshot());
+    // rates are averaged over time since the (thread's) table started,
+    // somewhere between t0 and t1
+    double const longest(std::chrono::duration<double>(x.at_-t0).count());
+    double const shortest(std::chrono::duration<double>(x.at_-t1).count());
+    size_t complete(0);
+    for(auto const& e: expected){
+      auto const i(x.rates_.find(e.first));
+      if (i!=x.rates_.end()){
+        xju::assert_less_equal(i->second.packets_*shortest,e.second+1e-6);
+        xju::assert_less(
+          std::abs(i->second.bytes_-i->second.packets_*frameSize),
+          1e-6*i->second.bytes_);
+        if (i->second.packets_*longest>=e.second-1e-6){
+          ++complete;
+        }
+      }
+    }
+    if (complete==expected.size()){
+      xju::assert_equal(x.malformed_,0U);
+      xju::assert_equal(x.evictions_,0U);
+      xju::assert_equal(x.drops_,0U);
+      break;
+    }
+    xju::assert_less(xju::steadyNow(),deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <lanstats/RateTable.hh>
+
+#include <iostream>
+#include <map>
+#include <atomic>
+#include <cmath>
+#include <xju/assert.hh>
+#include <xju/Thread.hh>
+#include <xju/steadyNow.hh>
+
+namespace lanstats
+{
+
+Key key(uint32_t i)
+{
+  return Key{xju::ip::Protocol(i%3?6:17),
+             xju::ip::Port(i%7),
+             xju::ip::v4::Address(0xc0a80000+i)};
+}
+
+std::map<Key,Rate> all(RateTable const& x,
+                       std::chrono::steady_clock::time_point const now)
+{
+  std::map<Key,Rate> result;
+  x.forEach(now,[&](Key const& k, Rate const& r){
+      xju::assert_equal(result.count(k),0U);
+      result[k]=r;
+    });
+  return result;
+}
+
+void assert_rate(Rate const& x, double const bytes, double const packets)
+{
+  xju::assert_less(std::abs(x.bytes_-bytes),1e-9*bytes);
+  xju::assert_less(std::abs(x.packets_-packets),1e-9*packets);
+}
+
+// rates over sliding window, including key 0
+void test1() {
+  auto const t(xju::steadyNow());
+  auto const ms([&](int x){ return t+std::chrono::milliseconds(x); });
+  RateTable x(16,4,std::chrono::seconds(1),t);
+  xju::assert_equal(all(x,t).size(),0U);
+  Key const zero{xju::ip::Protocol(0),xju::ip::Port(0),
+                 xju::ip::v4::Address(0)};
+  x.add(zero,60,ms(100));
+  x.add(key(1),100,ms(500));
+  x.add(key(1),200,ms(1500));
+  x.add(key(2),64,ms(1500));
+  {
+    // averaged since start
+    auto const y(all(x,ms(2000)));
+    xju::assert_equal(y.size(),3U);
+    assert_rate(y.at(zero),30,0.5);
+    assert_rate(y.at(key(1)),150,1);
+    assert_rate(y.at(key(2)),32,0.5);
+  }
+  {
+    // averaged over window (last 3.5 buckets), first bucket expired
+    auto const y(all(x,ms(4500)));
+    xju::assert_equal(y.size(),2U);
+    assert_rate(y.at(key(1)),200/3.5,1/3.5);
+    assert_rate(y.at(key(2)),64/3.5,1/3.5);
+  }
+  x.add(key(1),10,ms(4900));
+  {
+    auto const y(all(x,ms(4900)));
+    xju::assert_equal(y.size(),2U);
+    assert_rate(y.at(key(1)),210/3.9,2/3.9);
+    assert_rate(y.at(key(2)),64/3.9,1/3.9);
+  }
+  {
+    auto const y(all(x,ms(7500)));
+    xju::assert_equal(y.size(),1U);
+    assert_rate(y.at(key(1)),10/3.5,1/3.5);
+  }
+  xju::assert_equal(all(x,ms(8000)).size(),0U);
+  xju::assert_equal(x.evictions(),0U);
+}
+
+// full table: busier key replaces least busy key
+void test2() {
+  auto const t(xju::steadyNow());
+  auto const ms([&](int x){ return t+std::chrono::milliseconds(x); });
+  // one set
+  RateTable x(1,2,std::chrono::seconds(1),t);
+  for(uint32_t i=0; i!=8; ++i){
+    x.add(key(i),i==3?90:100,ms(0));
+  }
+  x.add(key(8),50,ms(100));
+  xju::assert_equal(x.evictions(),0U);
+  xju::assert_equal(all(x,ms(1000)).count(key(8)),0U);
+  x.add(key(8),45,ms(200));
+  xju::assert_equal(x.evictions(),1U);
+  auto const y(all(x,ms(1000)));
+  xju::assert_equal(y.size(),8U);
+  xju::assert_equal(y.count(key(3)),0U);
+  assert_rate(y.at(key(8)),95,1);
+  assert_rate(y.at(key(0)),100,1);
+}
+
+// reader concurrent with writer sees each key's bytes and packets
+// consistent, and finally sees all traffic
+void test3() {
+  uint32_t const K(5000);
+  uint32_t const N(1000000);
+  auto const t(xju::steadyNow());
+  RateTable x(4*K,10,std::chrono::seconds(1),t);
+  std::atomic<bool> done(false);
+  size_t reads(0);
+  {
+    xju::Thread reader([&](){
+        do{
+          for(auto const& z: all(x,xju::steadyNow())){
+            xju::assert_less(std::abs(z.second.bytes_-z.second.packets_*64),
+                             1e-9*z.second.bytes_);
+          }
+          ++reads;
+        }
+        while(!done.load());
+      });
+    for(uint32_t i=0; i!=N; ++i){
+      x.add(key(i%K),64,t+std::chrono::nanoseconds(i));
+    }
+    done.store(true);
+  }
+  auto const y(all(x,t+std::chrono::seconds(1)));
+  xju::assert_equal(y.size(),K);
+  for(uint32_t i=0; i!=K; ++i){
+    assert_rate(y.at(key(i)),N/K*64.0,N/K*1.0);
+  }
+  xju::assert_equal(x.evictions(),0U);
+  xju::assert_greater(reads,0U);
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <lanstats/Service.hh>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <xju/assert.hh>
+#include <xju/Thread.hh>
+#include <xju/steadyNow.hh>
+#include <xju/ip/UDPSocket.hh>
+#include <xju/ip/v4/Address.hh>
+
+namespace lanstats
+{
+
+// rates of loopback datagrams
+void test1() {
+  Engine engine("lo",1,1000,std::chrono::milliseconds(500),4U<<20);
+  std::ostringstream log;
+  Service service(engine,std::chrono::milliseconds(50),log);
+  xju::assert_equal(service.getCurrentStats().size(),0U);
+  xju::ip::UDPSocket receiver;
+  xju::ip::UDPSocket sender;
+  Protocol_PortPair const pp(
+    ProtocolName("udp"),
+    IpPortNumber(std::min(sender.port(),receiver.port()).value()));
+  IpAddress const localhost(xju::ip::v4::Address("127.0.0.1").value());
+  xju::Thread t([&](){ service.run(); },[&](){ service.stop(); });
+  char const payload[1000]={0};
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  while(true){
+    for(int i=0; i!=10; ++i){
+      sender.sendTo({xju::ip::v4::Address("127.0.0.1"),receiver.port()},
+                    payload,sizeof(payload),
+                    xju::steadyNow()+std::chrono::seconds(1));
+      char x[sizeof(payload)];
+      receiver.receive(x,sizeof(x),xju::steadyNow()+std::chrono::seconds(1));
+    }
+    auto const x(service.getCurrentStats());
+    auto const i(std::find_if(x.begin(),x.end(),[&](StatPair const& y){
+          return y.first==ProtocolPort_SourceIpAddressPair(pp,localhost);
+        }));
+    if (i!=x.end() && i->second.value()>0){
+      break;
+    }
+    xju::assert_less(xju::steadyNow(),deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  xju::assert_equal(log.str(),"");
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
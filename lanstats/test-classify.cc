@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <lanstats/classify.hh>
+
+#include <iostream>
+#include <vector>
+#include <iterator>
+#include <xju/assert.hh>
+#include <xju/ip/v4/encodeHeader.hh>
+
+namespace lanstats
+{
+
+typedef xju::ip::v4::Header Header;
+
+// ethernet frame with ethertype(s) etherTypes, carrying IPv4 protocol p
+// from source, fragment offset fragment, whose payload starts with
+// 16-bit values ports
+std::vector<uint8_t> frame(std::vector<uint16_t> const& etherTypes,
+                           uint8_t const p,
+                           uint16_t const fragment,
+                           xju::ip::v4::Address const& source,
+                           std::vector<uint16_t> const& ports)
+{
+  std::vector<uint8_t> result(12,0xee);
+  for(auto t: etherTypes){
+    result.push_back(t>>8);
+    result.push_back(t&0xff);
+  }
+  xju::ip::v4::encodeHeader(
+    Header(Header::Version(4),
+           Header::IHL(5),
+           Header::DSCP(0),
+           Header::ECN(0),
+           Header::TotalLength(20+2*ports.size()),
+           Header::Identification(7),
+           Header::Flags(0),
+           Header::FragmentOffset(fragment),
+           Header::TTL(64),
+           Header::Protocol(p),
+           Header::HeaderChecksum(0),
+           source,
+           xju::ip::v4::Address("10.0.0.1"),
+           {}),
+    std::back_inserter(result));
+  for(auto x: ports){
+    result.push_back(x>>8);
+    result.push_back(x&0xff);
+  }
+  return result;
+}
+
+xju::Optional<Key> classify(std::vector<uint8_t> const& x)
+{
+  return classify(x.data(),x.size());
+}
+
+xju::ip::v4::Address const a("192.168.0.3");
+
+// tcp, udp, sctp use lower port; others port 0
+void test1() {
+  xju::assert_equal(
+    classify(frame({0x0800},6,0,a,{54375,80})).value(),
+    Key{xju::ip::Protocol(6),xju::ip::Port(80),a});
+  xju::assert_equal(
+    classify(frame({0x0800},17,0,a,{53,39928})).value(),
+    Key{xju::ip::Protocol(17),xju::ip::Port(53),a});
+  xju::assert_equal(
+    classify(frame({0x0800},132,0,a,{3868,40000})).value(),
+    Key{xju::ip::Protocol(132),xju::ip::Port(3868),a});
+  xju::assert_equal(
+    classify(frame({0x0800},1,0,a,{0x0800,0})).value(),
+    Key{xju::ip::Protocol(1),xju::ip::Port(0),a});
+}
+
+// VLAN tags; non-IPv4
+void test2() {
+  xju::assert_equal(
+    classify(frame({0x8100,5,0x0800},17,0,a,{53,39928})).value(),
+    Key{xju::ip::Protocol(17),xju::ip::Port(53),a});
+  xju::assert_equal(
+    classify(frame({0x88a8,5,0x8100,6,0x0800},6,0,a,{22,60000})).value(),
+    Key{xju::ip::Protocol(6),xju::ip::Port(22),a});
+  xju::assert_equal(classify(frame({0x0806},6,0,a,{22,60000})).valid(),
+                    false);
+  xju::assert_equal(classify(frame({0x86dd},6,0,a,{22,60000})).valid(),
+                    false);
+}
+
+// non-first fragment has no ports
+void test3() {
+  xju::assert_equal(
+    classify(frame({0x0800},17,185,a,{53,39928})).value(),
+    Key{xju::ip::Protocol(17),xju::ip::Port(0),a});
+}
+
+// truncated and invalid
+void test4() {
+  auto const x(frame({0x0800},6,0,a,{54375,80}));
+  for(size_t n: {0U,13U,14U,33U,34U,36U}){
+    try{
+      auto const k(classify(x.data(),n));
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_not_equal(readableRepr(e).find("end of input"),
+                            std::string::npos);
+    }
+  }
+  auto y(x);
+  y[14]=0x65;
+  try{
+    auto const k(classify(y));
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_not_equal(readableRepr(e).find("not 4"),std::string::npos);
+  }
+}
+
+}
+
+using namespace lanstats;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -55,12 +55,14 @@ namespace xju
     const std::vector<std::pair<std::string, xju::Traced> >& Exception::context()
 	const throw()
     {
+        renderLazyContext();
 	return _context;
     }
     
     void Exception::addContext(const std::string& c,
 			       const xju::Traced& t) throw()
     {
+        renderLazyContext();
 	_context.push_back(std::make_pair(c, t));
         what_=std::string();
     }
@@ -68,6 +70,7 @@ namespace xju
         const std::string& c,
         std::pair<std::string,int> const& trace) throw()
     {
+        renderLazyContext();
         _context.push_back(std::make_pair(c,Traced(trace)));
         what_=std::string();
     }
@@ -76,6 +79,7 @@ namespace xju
         const std::string& c,
         std::pair<char const*,int> const& trace) throw()
     {
+        renderLazyContext();
         _context.push_back(
             std::make_pair(c,
                            Traced(trace.first,trace.second)));
@@ -86,6 +90,7 @@ namespace xju
         const char* c,
         std::pair<char const*,int> const& trace) throw()
     {
+        renderLazyContext();
         _context.push_back(
             std::make_pair(c,
                            Traced(trace.first,trace.second)));
@@ -95,15 +100,45 @@ namespace xju
     void Exception::addContext(const std::ostringstream& c,
 			       const xju::Traced& t) throw()
     {
+        renderLazyContext();
 	_context.push_back(std::make_pair(c.str(), t));
         what_=std::string();
     }
     void Exception::addContext(
         std::pair<std::string, xju::Traced> const& c) throw()
     {
+        renderLazyContext();
         _context.push_back(c);
         what_=std::string();
     }
+
+    void Exception::addLazyContext(LazyContext const& c) throw()
+    {
+        if (!lazy_.capacity()) {
+            // avoid repeated reallocation as typical call stack unwinds
+            lazy_.reserve(8);
+        }
+        lazy_.push_back(c);
+        what_=std::string();
+    }
+
+    void Exception::renderLazyContext() const throw()
+    {
+        xju::Lock l(lazyGuard_);
+        if (lazy_.size()) {
+            for(auto const& x: lazy_) {
+                _context.push_back(x.render());
+            }
+            lazy_.clear();
+        }
+    }
+
+    std::pair<std::string, xju::Traced> LazyContext::render() const throw()
+    {
+        std::ostringstream s;
+        format_(s, &f_);
+        return std::make_pair(s.str(), xju::Traced(file_, line_));
+    }
     
     const char* Exception::what() const throw()
     {
@@ -38,6 +38,18 @@
 //      }
 //   }
 //
+//   Where failure is expected to be common (e.g. trying several
+//   decoders in turn), context can be added lazily, so that its
+//   text is only formatted if the exception is actually rendered:
+//
+//      catch(xju::Exception& e)
+//      {
+//         e.addLazyContext(
+//           [fd](std::ostream& s){ s << "read from fd " << fd; },
+//           {__FILE__,__LINE__});
+//         throw;
+//      }
+//
 // See Also:
 //
 #ifndef _XJU_EXCEPTION_HH_
@@ -52,9 +64,60 @@
 #include <sstream>
 #include <xju/Mutex.hh>
 #include <exception>
+#include <type_traits>
+#include <cstddef>
+#include <new>
 
 namespace xju
 {
+    //
+    // Exception context whose text is formatted only on demand.
+    //
+    // Holds a copy of a small, trivially copyable function object
+    // f (typically a lambda capturing ints, offsets, string literals
+    // etc by value) that is called as f(std::ostream&) to write the
+    // context text. Note f is called after the stack has unwound, so
+    // it must not refer to (capture pointers or references to) objects
+    // that might not outlive the exception.
+    //
+    class LazyContext
+    {
+    public:
+        enum { CAPACITY=48 };
+
+        template<class F>
+        LazyContext(F const& f, char const* file, unsigned int line) throw():
+            file_(file),
+            line_(line),
+            format_(&LazyContext::call<F>)
+        {
+            static_assert(std::is_trivially_copyable<F>::value,
+                          "lazy context must capture by value only, "
+                          "and only trivially copyable values");
+            static_assert(sizeof(F)<=CAPACITY,
+                          "lazy context captures too much");
+            static_assert(alignof(F)<=alignof(std::max_align_t),
+                          "lazy context capture over-aligned");
+            new(&f_) F(f);
+        }
+
+        // format text and trace
+        std::pair<std::string, xju::Traced> render() const throw();
+
+    private:
+        char const* file_;
+        unsigned int line_;
+        void (*format_)(std::ostream& s, void const* f);
+        std::aligned_storage<CAPACITY,
+                             alignof(std::max_align_t)>::type f_;
+
+        template<class F>
+        static void call(std::ostream& s, void const* f)
+        {
+            (*static_cast<F const*>(f))(s);
+        }
+    };
+    
     class Exception : public std::exception
     {
     public:
@@ -78,11 +141,13 @@ namespace xju
                   xju::Traced trace) throw();
 	Exception(Exception const& x) throw():
             _cause(x._cause),
-            _context(x._context) {
+            _context(x._context),
+            lazy_(x.lazy_) {
         }
 	Exception(Exception const&& x) throw():
             _cause(std::move(x._cause)),
             _context(std::move(x._context)),
+            lazy_(std::move(x.lazy_)),
             what_(std::move(x.what_)) {
         }
         Exception(std::pair<std::string, xju::Traced> cause,
@@ -95,6 +160,7 @@ namespace xju
             if (this != &x) {
                 _cause=x._cause;
                 _context=x._context;
+                lazy_=x.lazy_;
                 what_=std::string();
             }
             return *this;
@@ -104,6 +170,7 @@ namespace xju
             if (this != &x) {
                 _cause=std::move(x._cause);
                 _context=std::move(x._context);
+                lazy_=std::move(x.lazy_);
                 what_=std::move(x.what_);
             }
             return *this;
@@ -117,6 +184,9 @@ namespace xju
 	//
 	// Report context.
 	//
+	// Formats any lazy context (see addLazyContext) that has not
+	// yet been formatted.
+	//
 	const std::vector<std::pair<std::string, xju::Traced> >& context() const
 	    throw();
 	
@@ -140,6 +210,22 @@ namespace xju
                         const xju::Traced& trace) throw();
 	void addContext(std::pair<std::string, xju::Traced> const& trace) 
           throw();
+
+	//
+	// Add context whose text is written by f(std::ostream&) only
+	// when needed, i.e. by context(), what(), readableRepr() etc.
+	// See LazyContext for restrictions on f.
+	//
+	// post: as for addContext(c, trace) where c is the text
+	//       f writes
+	//
+	template<class F>
+	void addLazyContext(F const& f,
+                            std::pair<char const*,int> const& trace) throw()
+	{
+	    addLazyContext(LazyContext(f, trace.first, trace.second));
+	}
+	void addLazyContext(LazyContext const& c) throw();
 	
 	virtual ~Exception() throw() {}
 
@@ -149,16 +235,24 @@ namespace xju
 
     private:
 	std::pair<std::string, xju::Traced> _cause;
-	std::vector<std::pair<std::string, xju::Traced> > _context;
+	mutable std::vector<std::pair<std::string, xju::Traced> > _context;
+
+        // context added after _context, not yet formatted
+        mutable std::vector<LazyContext> lazy_;
+        mutable xju::Mutex lazyGuard_;
+
         mutable xju::Mutex guard_;
         mutable std::string what_;
 
+        // format lazy_ onto end of _context
+        void renderLazyContext() const throw();
+
         friend bool operator<(Exception const& x, Exception const& y) throw()
         {
             if (x._cause < y._cause) return true;
             if (y._cause < x._cause) return false;
-            if (x._context < y._context) return true;
-            if (y._context < x._context) return false;
+            if (x.context() < y.context()) return true;
+            if (y.context() < x.context()) return false;
             return false;
         }
         friend bool operator>(Exception const& x, Exception const& y) throw()
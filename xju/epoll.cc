@@ -0,0 +1,20 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/epoll.hh>
+
+#include <sys/epoll.h>
+
+namespace xju
+{
+const SyscallF1<int,int> epoll_create1={
+  "::epoll_create1",::epoll_create1};
+const SyscallF4<int,int,int,int,struct epoll_event*> epoll_ctl={
+  "::epoll_ctl",::epoll_ctl};
+}
@@ -0,0 +1,22 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#ifndef _XJU_EPOLL_HH
+#define _XJU_EPOLL_HH
+
+#include "xju/syscall.hh"
+
+struct epoll_event;
+
+namespace xju
+{
+extern const xju::SyscallF1<int,int> epoll_create1;
+extern const xju::SyscallF4<int,int,int,int,struct epoll_event*> epoll_ctl;
+}
+#endif
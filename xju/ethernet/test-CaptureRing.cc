@@ -0,0 +1,226 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/ethernet/CaptureRing.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/steadyNow.hh>
+#include <xju/ip/UDPSocket.hh>
+#include <xju/ip/v4/Address.hh>
+#include <xju/DeadlineReached.hh>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <unistd.h>
+#include <cstring>
+#include <map>
+#include <set>
+#include <memory>
+#include <vector>
+
+namespace xju
+{
+namespace ethernet
+{
+
+// classic BPF accepting IPv4 UDP datagrams to port (as tcpdump -dd
+// "udp dst port N", less fragment handling)
+std::vector<sock_filter> udpDstPort(uint16_t port)
+{
+  return {
+    { 0x28, 0, 0, 12 },      // ldh [12]
+    { 0x15, 0, 6, 0x0800 },  // jeq #IPv4 else drop
+    { 0x30, 0, 0, 23 },      // ldb [23]
+    { 0x15, 0, 4, 17 },      // jeq #UDP else drop
+    { 0xb1, 0, 0, 14 },      // ldxb 4*([14]&0xf)
+    { 0x48, 0, 0, 16 },      // ldh [x+16]
+    { 0x15, 0, 1, port },    // jeq #port else drop
+    { 0x06, 0, 0, 0x40000 }, // ret #262144
+    { 0x06, 0, 0, 0 }        // ret #0
+  };
+}
+
+// payloads (sequence numbers) of UDP datagrams of frames of b
+std::vector<uint32_t> payloads(CaptureRing::Block const& b)
+{
+  std::vector<uint32_t> result;
+  for(auto const& f: b){
+    // ethernet + 20 byte IP header (no options) + UDP header
+    xju::assert_equal(f.size(),14U+20U+8U+4U);
+    xju::assert_equal(f.length(),f.size());
+    uint32_t x;
+    ::memcpy(&x,f.data()+14+20+8,sizeof(x));
+    result.push_back(x);
+  }
+  return result;
+}
+
+// capture of loopback datagrams, filtered
+void test1() {
+  xju::ip::UDPSocket receiver;
+  xju::ip::UDPSocket sender;
+  CaptureRing ring("lo",Protocol(ETH_P_IP),1U<<16,8,
+                   std::chrono::milliseconds(1));
+  ring.attachFilter(udpDstPort(receiver.port().value()));
+  {
+    // nothing yet
+    auto const t(xju::steadyNow());
+    try{
+      ring.next(t+std::chrono::milliseconds(20));
+      xju::assert_never_reached();
+    }
+    catch(xju::DeadlineReached const&){
+      xju::assert_greater_equal(xju::steadyNow(),
+                                t+std::chrono::milliseconds(20));
+    }
+  }
+  auto const before(std::chrono::system_clock::now());
+  uint32_t const N(2000);
+  std::vector<uint32_t> captured;
+  std::chrono::system_clock::time_point last(before);
+  int const lo(::if_nametoindex("lo"));
+  size_t blocks(0);
+  // read blocks handed over by deadline
+  auto const read([&](std::chrono::steady_clock::time_point const& deadline){
+      try{
+        while(captured.size()<N){
+          auto const b(ring.next(deadline));
+          ++blocks;
+          xju::assert_equal(b.framesLost(),false);
+          for(auto const& f: b){
+            xju::assert_equal(f.protocol(),Protocol(ETH_P_IP));
+            xju::assert_equal(f.interfaceIndex(),lo);
+            xju::assert_equal((int)f.packetType(),PACKET_HOST);
+            xju::assert_greater_equal(f.timestamp(),last);
+            xju::assert_less_equal(f.timestamp(),
+                                   std::chrono::system_clock::now());
+            last=f.timestamp();
+          }
+          auto const x(payloads(b));
+          captured.insert(captured.end(),x.begin(),x.end());
+        }
+      }
+      catch(xju::DeadlineReached const&){
+      }
+    });
+  for(uint32_t i=0; i!=N; ++i){
+    sender.sendTo({xju::ip::v4::Address("127.0.0.1"),receiver.port()},
+                  &i,sizeof(i),xju::steadyNow()+std::chrono::seconds(1));
+    char x[4];
+    receiver.receive(x,sizeof(x),xju::steadyNow()+std::chrono::seconds(1));
+    if (i%100==99){
+      read(xju::steadyNow());
+    }
+  }
+  read(xju::steadyNow()+std::chrono::seconds(1));
+  xju::assert_equal(captured.size(),N);
+  xju::assert_greater(blocks,1U);
+  for(uint32_t i=0; i!=N; ++i){
+    xju::assert_equal(captured[i],i);
+  }
+  {
+    auto const s(ring.stats());
+    xju::assert_equal(s.frames_,N);
+    xju::assert_equal(s.drops_,0U);
+  }
+
+  // ring of 2 small blocks not read while 200 frames arrive, so
+  // kernel drops some
+  CaptureRing small("lo",Protocol(ETH_P_IP),::getpagesize(),2,
+                    std::chrono::milliseconds(1));
+  small.attachFilter(udpDstPort(receiver.port().value()));
+  for(uint32_t i=0; i!=200; ++i){
+    sender.sendTo({xju::ip::v4::Address("127.0.0.1"),receiver.port()},
+                  &i,sizeof(i),xju::steadyNow()+std::chrono::seconds(1));
+    char x[4];
+    receiver.receive(x,sizeof(x),xju::steadyNow()+std::chrono::seconds(1));
+  }
+  {
+    auto const s(small.stats());
+    xju::assert_equal(s.frames_,200U);
+    xju::assert_greater(s.drops_,0U);
+    xju::assert_greater(s.freezes_,0U);
+  }
+  small.next(xju::steadyNow()).release();
+}
+
+// fanout by flow hash over two rings
+void test2() {
+  xju::ip::UDPSocket receiver;
+  uint16_t const group(::getpid()&0xffff);
+  std::vector<std::unique_ptr<CaptureRing> > rings;
+  for(int i=0; i!=2; ++i){
+    rings.push_back(std::unique_ptr<CaptureRing>(
+                      new CaptureRing("lo",Protocol(ETH_P_IP),1U<<16,8,
+                                      std::chrono::milliseconds(1))));
+    rings.back()->attachFilter(udpDstPort(receiver.port().value()));
+    rings.back()->joinFanout(group,CaptureRing::Fanout::HASH);
+  }
+  // 20 flows (senders) of 10 datagrams, each datagram carrying its flow
+  uint32_t const FLOWS(20);
+  uint32_t const PER_FLOW(10);
+  {
+    std::vector<std::unique_ptr<xju::ip::UDPSocket> > senders;
+    for(uint32_t i=0; i!=FLOWS; ++i){
+      senders.push_back(std::unique_ptr<xju::ip::UDPSocket>(
+                          new xju::ip::UDPSocket));
+    }
+    for(uint32_t j=0; j!=PER_FLOW; ++j){
+      for(uint32_t i=0; i!=FLOWS; ++i){
+        senders[i]->sendTo(
+          {xju::ip::v4::Address("127.0.0.1"),receiver.port()},
+          &i,sizeof(i),xju::steadyNow()+std::chrono::seconds(1));
+      }
+    }
+  }
+  // flow -> ring -> frames
+  std::map<uint32_t,std::map<size_t,size_t> > seen;
+  size_t total(0);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  while(total<FLOWS*PER_FLOW){
+    xju::assert_less(xju::steadyNow(),deadline);
+    for(size_t r=0; r!=rings.size(); ++r){
+      try{
+        auto const b(rings[r]->next(xju::steadyNow()+
+                                    std::chrono::milliseconds(10)));
+        for(auto x: payloads(b)){
+          ++seen[x][r];
+          ++total;
+        }
+      }
+      catch(xju::DeadlineReached const&){
+      }
+    }
+  }
+  xju::assert_equal(total,FLOWS*PER_FLOW);
+  xju::assert_equal(seen.size(),FLOWS);
+  std::set<size_t> used;
+  for(auto const& x: seen){
+    // each flow on one ring
+    xju::assert_equal(x.second.size(),1U);
+    xju::assert_equal((*x.second.begin()).second,PER_FLOW);
+    used.insert((*x.second.begin()).first);
+  }
+  // (20 flows all hashing to one ring is improbable)
+  xju::assert_equal(used.size(),2U);
+}
+
+}
+}
+
+using namespace xju::ethernet;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
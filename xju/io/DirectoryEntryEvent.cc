@@ -22,6 +22,7 @@ std::ostream& operator<<(std::ostream& s, DirectoryEntryEvent const& x)
   case DirectoryEntryEvent::WRITER_CLOSED: return s<<"entry written to";
   case DirectoryEntryEvent::ENTRY_ADDED: return s<<"entry added";
   case DirectoryEntryEvent::ENTRY_REMOVED: return s<< "entry removed";
+  case DirectoryEntryEvent::CONTENT_MODIFIED: return s<< "entry modified";
   }
   return s << xju::format::str((uint32_t)x);
 }
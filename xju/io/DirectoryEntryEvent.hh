@@ -7,7 +7,8 @@
 // software for any purpose.  It is provided "as is" without express or
 // implied warranty.
 //
-
+#ifndef _XJU_IO_DIRECTORYENTRYEVENT_HH
+#define _XJU_IO_DIRECTORYENTRYEVENT_HH
 
 #include <iostream>
 #include <sys/inotify.h>
@@ -22,12 +23,12 @@ enum class DirectoryEntryEvent : uint32_t {
   METADATA_CHANGED=IN_ATTRIB,
   WRITER_CLOSED=IN_CLOSE_WRITE,
   ENTRY_ADDED=IN_CREATE|IN_MOVED_TO,
-  ENTRY_REMOVED=IN_DELETE|IN_MOVED_FROM
+  ENTRY_REMOVED=IN_DELETE|IN_MOVED_FROM,
+  CONTENT_MODIFIED=IN_MODIFY
 };
 
 std::ostream& operator<<(std::ostream& s, DirectoryEntryEvent const& x);
     
 }
 }
-
-
+#endif
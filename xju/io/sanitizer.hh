@@ -0,0 +1,24 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#ifndef _XJU_IO_SANITIZER_HH
+#define _XJU_IO_SANITIZER_HH
+
+// address sanitizer stack annotations, only when building with
+// -fsanitize=address (so that other builds do not need the sanitizer
+// headers)
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/common_interface_defs.h>
+#include <sanitizer/asan_interface.h>
+#else
+// as asan_interface.h defines it without address sanitizer
+#define ASAN_UNPOISON_MEMORY_REGION(addr,size) ((void)(addr),(void)(size))
+#endif
+
+#endif
@@ -45,18 +45,20 @@ void test1() {
 
   auto const a(xju::path::split("x/a"));
   auto const b(xju::path::split("x/b"));
+
+  InotifyService s;
   
   // in dir, each event, verify only that event
   {
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::ENTRY_ADDED});
+      s,d,{xju::io::DirectoryEntryEvent::ENTRY_ADDED});
     xju::file::touch(a,mode);
     xju::assert_equal(x.read(xju::steadyNow()),
                       es({e(a,xju::io::DirectoryEntryEvent::ENTRY_ADDED)}));
   }
   {
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
+      s,d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
     xju::file::chmod(a,xju::file::Mode(0776));
     xju::assert_equal(x.read(xju::steadyNow()),
                       es({e(a,xju::io::DirectoryEntryEvent::METADATA_CHANGED)}));
@@ -65,7 +67,7 @@ void test1() {
   }
   {
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::WRITER_CLOSED});
+      s,d,{xju::io::DirectoryEntryEvent::WRITER_CLOSED});
     xju::file::write(a,"fred",4,mode);
     xju::assert_equal(x.read(xju::steadyNow()),
                       es({e(a,xju::io::DirectoryEntryEvent::WRITER_CLOSED)}));
@@ -74,7 +76,7 @@ void test1() {
   }
   {
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::ENTRY_REMOVED});
+      s,d,{xju::io::DirectoryEntryEvent::ENTRY_REMOVED});
     xju::file::rm(a);
     xju::assert_equal(x.read(xju::steadyNow()),
                       es({e(a,xju::io::DirectoryEntryEvent::ENTRY_REMOVED)}));
@@ -85,7 +87,7 @@ void test1() {
   // exclude self change
   {
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
+      s,d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
     xju::file::chmod(d,xju::file::Mode(0776));
     xju::assert_equal(x.read(xju::steadyNow()),
                       es({}));
@@ -95,7 +97,7 @@ void test1() {
   {
     auto const deadline(xju::steadyNow()+std::chrono::milliseconds(20));
     xju::io::DirectoryObserver x(
-      d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
+      s,d,{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
     xju::assert_equal(x.read(deadline),
                       es({}));
     xju::assert_greater_equal(xju::steadyNow(),deadline);
@@ -103,7 +105,7 @@ void test1() {
   // non existent
   try{
     xju::io::DirectoryObserver x(
-      xju::path::splitdir("x/a"),{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
+      s,xju::path::splitdir("x/a"),{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
     xju::assert_never_reached();
   }
   catch(xju::SyscallFailed const& e){
@@ -113,7 +115,7 @@ void test1() {
   try{
     xju::file::touch(b,mode);
     xju::io::DirectoryObserver x(
-      xju::path::splitdir("x/b"),{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
+      s,xju::path::splitdir("x/b"),{xju::io::DirectoryEntryEvent::METADATA_CHANGED});
     xju::assert_never_reached();
   }
   catch(xju::SyscallFailed const& e){
@@ -15,7 +15,8 @@ namespace io
 {
 void test0() //header check
 {
-  FileObserver o({});
+  InotifyService s;
+  FileObserver o(s,{});
 }
 
 }
@@ -29,6 +30,7 @@ void test0() //header check
 #include <xju/file/rename.hh>
 #include <xju/io/select.hh>
 #include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
 
 namespace xju
 {
@@ -40,8 +42,9 @@ void test1() {
   auto const f2(xju::path::split("d2/f2"));
   auto const f3(xju::path::split("d1/f3"));
 
+  InotifyService s;
   try {
-    FileObserver o( {f1,f2} );
+    FileObserver o(s, {f1,f2} );
     xju::assert_never_reached();
   }
   catch(xju::Exception const& e) {
@@ -50,7 +53,7 @@ void test1() {
   xju::file::mkdir(xju::path::dirname(f1),xju::file::Mode(0777));
   xju::file::mkdir(xju::path::dirname(f2),xju::file::Mode(0777));
   
-  FileObserver o( {f1,f2} );
+  FileObserver o(s, {f1,f2} );
   xju::assert_equal(xju::io::select({&o},xju::steadyNow()).size(),0U);
   xju::assert_equal(o.read(xju::steadyNow()).size(),0U);
   
@@ -122,6 +125,60 @@ void test1() {
   
 }
 
+// coalescing window
+void test2() {
+  auto const f1(xju::path::split("d3/f1"));
+  xju::file::mkdir(xju::path::dirname(f1),xju::file::Mode(0777));
+
+  InotifyService s;
+  FileObserver o(s, {f1}, std::chrono::milliseconds(50) );
+  xju::assert_equal(o.nextDue(),xju::steadyEternity());
+
+  auto const t0(xju::steadyNow());
+  xju::file::write(f1,"fred",xju::file::Mode(0777));
+  xju::file::write(f1,"jock",xju::file::Mode(0777));
+  // not yet due
+  xju::assert_equal(o.read(xju::steadyNow()).size(),0U);
+  xju::assert_less_equal(o.nextDue(),t0+std::chrono::seconds(1));
+
+  auto const r(o.read(o.nextDue()+std::chrono::milliseconds(10)));
+  xju::assert_equal(r,std::set<std::pair<xju::path::AbsolutePath,xju::path::FileName>>({f1}));
+  xju::assert_greater_equal(xju::steadyNow(),t0+std::chrono::milliseconds(50));
+  xju::assert_equal(o.nextDue(),xju::steadyEternity());
+  xju::assert_equal(o.read(xju::steadyNow()).size(),0U);
+}
+
+// observers sharing a service
+void test3() {
+  auto const f1(xju::path::split("d4/f1"));
+  auto const f2(xju::path::split("d4/f2"));
+  auto const f3(xju::path::split("d5/f3"));
+  xju::file::mkdir(xju::path::dirname(f1),xju::file::Mode(0777));
+  xju::file::mkdir(xju::path::dirname(f3),xju::file::Mode(0777));
+
+  InotifyService s;
+  FileObserver o1(s, {f1} );
+  FileObserver o2(s, {f2,f3} );
+  xju::assert_equal(s.size(),2U);
+
+  xju::file::touch(f1,xju::file::Mode(0777));
+  xju::file::touch(f2,xju::file::Mode(0777));
+  xju::file::touch(f3,xju::file::Mode(0777));
+
+  // o1 reads all events from the kernel but gets only its own
+  xju::assert_equal(
+    o1.read(xju::steadyNow()+std::chrono::seconds(1)),
+    std::set<std::pair<xju::path::AbsolutePath,xju::path::FileName>>({f1}));
+  // ... keeping o2's, which are due now although o2 might not select
+  // readable
+  xju::assert_less_equal(o2.nextDue(),xju::steadyNow());
+  xju::assert_equal(
+    o2.read(xju::steadyNow()),
+    std::set<std::pair<xju::path::AbsolutePath,xju::path::FileName>>({f2,f3}));
+  xju::assert_equal(o1.nextDue(),xju::steadyEternity());
+  xju::assert_equal(o2.nextDue(),xju::steadyEternity());
+}
+
 }
 }
 
@@ -131,6 +188,8 @@ int main(int argc, char* argv[])
 {
   unsigned int n(0);
   test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
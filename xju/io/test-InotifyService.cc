@@ -0,0 +1,189 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/io/InotifyService.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/file/Mode.hh>
+#include <xju/file/mkdir.hh>
+#include <xju/file/rmdir.hh>
+#include <xju/file/touch.hh>
+#include <xju/file/write.hh>
+#include <xju/file/rm.hh>
+#include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
+#include <xju/SyscallFailed.hh>
+
+namespace xju
+{
+namespace io
+{
+
+typedef std::set<std::pair<xju::path::AbsFile,DirectoryEntryEvent> > Es;
+
+std::pair<xju::path::AbsFile,DirectoryEntryEvent> e(
+  xju::path::AbsFile f, DirectoryEntryEvent event){
+  return std::make_pair(f,event);
+}
+
+xju::file::Mode const mode(0777);
+
+// coalescing, timeout, missing directory
+void test1() {
+  auto const d(xju::path::splitdir("i1"));
+  xju::file::mkdir(d,mode); //assume does not exist
+  auto const a(xju::path::split("i1/a"));
+  auto const b(xju::path::split("i1/b"));
+  {
+    InotifyService s(std::chrono::milliseconds(100));
+    InotifyService::Watch w(s,d,{DirectoryEntryEvent::ENTRY_ADDED,
+                                 DirectoryEntryEvent::WRITER_CLOSED});
+    xju::assert_equal(s.size(),1U);
+    auto const t1(xju::steadyNow());
+    xju::file::touch(a,mode);
+    for(int i=0; i!=10; ++i){
+      xju::file::write(a,"fred",4,mode);
+    }
+    xju::file::touch(b,mode);
+    // nothing due yet
+    xju::assert_equal(s.read(xju::steadyNow()).empty(),true);
+    auto const c(s.read(t1+std::chrono::seconds(1)));
+    xju::assert_greater_equal(xju::steadyNow(),t1+std::chrono::milliseconds(100));
+    xju::assert_equal(c.changes_,Es({e(a,DirectoryEntryEvent::ENTRY_ADDED),
+                                     e(a,DirectoryEntryEvent::WRITER_CLOSED),
+                                     e(b,DirectoryEntryEvent::ENTRY_ADDED)}));
+    xju::assert_equal(c.rescan_.size(),0U);
+    xju::assert_equal(s.nextDue(),xju::steadyEternity());
+
+    // timeout
+    auto const deadline(xju::steadyNow()+std::chrono::milliseconds(20));
+    xju::assert_equal(s.read(deadline).empty(),true);
+    xju::assert_greater_equal(xju::steadyNow(),deadline);
+  }
+  {
+    InotifyService s;
+    try{
+      InotifyService::Watch w(s,xju::path::splitdir("i1/x"),
+                              {DirectoryEntryEvent::ENTRY_ADDED});
+      xju::assert_never_reached();
+    }
+    catch(xju::SyscallFailed const& e){
+      xju::assert_equal(e._errno,ENOENT);
+    }
+    xju::assert_equal(s.size(),0U);
+  }
+  xju::file::rm(a);
+  xju::file::rm(b);
+  xju::file::rmdir(d);
+}
+
+// multiple watches, of same and different directories
+void test2() {
+  auto const d1(xju::path::splitdir("i2"));
+  auto const d2(xju::path::splitdir("i2/d2"));
+  xju::file::mkdir(d1,mode);
+  xju::file::mkdir(d2,mode);
+  auto const a(xju::path::split("i2/a"));
+  auto const b(xju::path::split("i2/d2/b"));
+  {
+    InotifyService s;
+    InotifyService::Watch w1(s,d1,{DirectoryEntryEvent::ENTRY_ADDED});
+    InotifyService::Watch w2(s,d2,{DirectoryEntryEvent::ENTRY_ADDED});
+    xju::assert_equal(s.size(),2U);
+    {
+      InotifyService::Watch w3(s,d1,{DirectoryEntryEvent::ENTRY_REMOVED});
+      xju::assert_equal(s.size(),2U);
+      xju::file::touch(a,mode);
+      xju::file::touch(b,mode);
+      xju::file::rm(a);
+      xju::assert_equal(
+        s.read(xju::steadyNow()+std::chrono::seconds(1)).changes_,
+        Es({e(a,DirectoryEntryEvent::ENTRY_ADDED),
+            e(a,DirectoryEntryEvent::ENTRY_REMOVED),
+            e(b,DirectoryEntryEvent::ENTRY_ADDED)}));
+    }
+    // w3 gone
+    xju::assert_equal(s.size(),2U);
+    xju::file::touch(a,mode);
+    xju::file::rm(a);
+    xju::assert_equal(
+      s.read(xju::steadyNow()+std::chrono::seconds(1)).changes_,
+      Es({e(a,DirectoryEntryEvent::ENTRY_ADDED)}));
+    xju::file::rm(b);
+    xju::assert_equal(
+      s.read(xju::steadyNow()+std::chrono::milliseconds(50)).empty(),true);
+  }
+  xju::file::rmdir(d2);
+  xju::file::rmdir(d1);
+}
+
+// recursive
+void test3() {
+  auto const d1(xju::path::splitdir("i3"));
+  auto const d2(xju::path::splitdir("i3/d2"));
+  auto const d3(xju::path::splitdir("i3/d2/d3"));
+  xju::file::mkdir(d1,mode);
+  xju::file::mkdir(d2,mode);
+  auto const a(xju::path::split("i3/d2/a"));
+  auto const b(xju::path::split("i3/d2/d3/b"));
+  {
+    InotifyService s;
+    InotifyService::Watch w(s,d1,{DirectoryEntryEvent::ENTRY_ADDED,
+                                  DirectoryEntryEvent::ENTRY_REMOVED},true);
+    xju::assert_equal(s.size(),2U);
+    xju::file::touch(a,mode);
+    xju::assert_equal(
+      s.read(xju::steadyNow()+std::chrono::seconds(1)).changes_,
+      Es({e(a,DirectoryEntryEvent::ENTRY_ADDED)}));
+
+    // new subdirectory, with entry possibly created before its watch
+    xju::file::mkdir(d3,mode);
+    xju::file::touch(b,mode);
+    Es c;
+    auto const deadline(xju::steadyNow()+std::chrono::seconds(1));
+    while(c.size()<2){
+      auto const x(s.read(deadline).changes_);
+      xju::assert_equal(x.size()>0,true);
+      c.insert(x.begin(),x.end());
+    }
+    xju::assert_equal(
+      c,
+      Es({e(xju::path::split("i3/d2/d3"),DirectoryEntryEvent::ENTRY_ADDED),
+          e(b,DirectoryEntryEvent::ENTRY_ADDED)}));
+    xju::assert_equal(s.size(),3U);
+
+    // removed subdirectory
+    xju::file::rm(b);
+    xju::file::rmdir(d3);
+    xju::assert_equal(
+      s.read(xju::steadyNow()+std::chrono::seconds(1)).changes_,
+      Es({e(b,DirectoryEntryEvent::ENTRY_REMOVED),
+          e(xju::path::split("i3/d2/d3"),DirectoryEntryEvent::ENTRY_REMOVED)}));
+    xju::assert_equal(s.size(),2U);
+  }
+  xju::file::rm(a);
+  xju::file::rmdir(d2);
+  xju::file::rmdir(d1);
+}
+
+}
+}
+
+using namespace xju::io;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
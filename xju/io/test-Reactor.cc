@@ -0,0 +1,281 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/io/Reactor.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/pipe.hh>
+#include <xju/unistd.hh>
+#include <xju/AutoFd.hh>
+#include <xju/io/IStream.hh>
+#include <xju/io/OStream.hh>
+#include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
+#include <xju/Thread.hh>
+#include <memory>
+#include <vector>
+#include <thread>
+
+namespace xju
+{
+namespace io
+{
+
+size_t fillPipe(xju::io::OStream& pipeInput) noexcept
+{
+  size_t pipeMax(0);
+  size_t thisWrite(0);
+  do {
+    thisWrite=pipeInput.write(std::vector<uint8_t>(1024,0).data(),
+                              1024,
+                              xju::steadyNow());
+    pipeMax+=thisWrite;
+  }
+  while(thisWrite==1024);
+  return pipeMax;
+}
+
+size_t drain(xju::io::IStream& x) noexcept
+{
+  std::vector<uint8_t> r(1024,0);
+  size_t result(0);
+  size_t n;
+  while((n=x.read(r.data(),r.size(),xju::steadyNow()))){
+    result+=n;
+  }
+  return result;
+}
+
+// level triggered, deadline
+void test1() {
+  auto p1(xju::pipe(true,true));
+  auto p2(xju::pipe(true,true));
+
+  Reactor r;
+  std::vector<std::string> calls;
+  Reactor::Registration r1(r,*p1.first,[&](PollInputState s){
+      xju::assert_equal(s,PollInputState::IN);
+      calls.push_back("p1 readable");
+    });
+  Reactor::Registration r2(r,*p2.first,[&](PollInputState s){
+      calls.push_back("p2 readable");
+    });
+  xju::assert_equal(r.size(),2U);
+
+  // nothing ready, deadline passed
+  xju::assert_equal(r.wait(xju::steadyNow()),0U);
+
+  // nothing ready, wait for deadline
+  {
+    auto const t1(xju::steadyNow());
+    xju::assert_equal(r.wait(t1+std::chrono::milliseconds(100)),0U);
+    auto const t2(xju::steadyNow());
+    xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(100));
+    xju::assert_less(t2-t1,std::chrono::milliseconds(200));
+  }
+  xju::assert_equal(calls.size(),0U);
+
+  uint8_t const c('x');
+  p1.second->write(&c,1,xju::steadyNow());
+  xju::assert_equal(r.wait(xju::steadyNow()),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"p1 readable"}));
+
+  // level triggered so reported again
+  xju::assert_equal(r.wait(xju::steadyNow()),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"p1 readable",
+                                                    "p1 readable"}));
+  drain(*p1.first);
+  calls.clear();
+
+  // becomes ready before deadline
+  {
+    auto const t1(xju::steadyNow());
+    xju::Thread th([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        p2.second->write(&c,1,xju::steadyNow());
+      });
+    xju::assert_equal(r.wait(t1+std::chrono::milliseconds(1000)),1U);
+    auto const t2(xju::steadyNow());
+    xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(50));
+    xju::assert_less(t2-t1,std::chrono::milliseconds(500));
+    xju::assert_equal(calls,std::vector<std::string>({"p2 readable"}));
+  }
+  drain(*p2.first);
+
+  // hangup
+  calls.clear();
+  p2.second.reset();
+  xju::assert_equal(r.wait(xju::steadyNow()),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"p2 readable"}));
+}
+
+// edge triggered, output
+void test2() {
+  auto p1(xju::pipe(true,true));
+
+  Reactor r;
+  std::vector<std::string> calls;
+  {
+    Reactor::Registration r1(r,*p1.first,[&](PollInputState s){
+        calls.push_back("p1 readable");
+      },
+      Reactor::Trigger::EDGE);
+    uint8_t const c('x');
+    p1.second->write(&c,1,xju::steadyNow());
+    xju::assert_equal(r.wait(xju::steadyNow()),1U);
+    // edge triggered so not reported again
+    xju::assert_equal(r.wait(xju::steadyNow()),0U);
+    p1.second->write(&c,1,xju::steadyNow());
+    xju::assert_equal(r.wait(xju::steadyNow()),1U);
+    xju::assert_equal(calls.size(),2U);
+    drain(*p1.first);
+  }
+  xju::assert_equal(r.size(),0U);
+  calls.clear();
+  {
+    Reactor::Registration r1(r,*p1.second,[&](PollOutputState s){
+        xju::assert_equal(s,PollOutputState::OUT);
+        calls.push_back("p1 writable");
+      });
+    xju::assert_equal(r.wait(xju::steadyNow()),1U);
+    xju::assert_equal(calls.size(),1U);
+    fillPipe(*p1.second);
+    xju::assert_equal(r.wait(xju::steadyNow()),0U);
+    drain(*p1.first);
+    xju::assert_equal(r.wait(xju::steadyNow()),1U);
+    xju::assert_equal(calls.size(),2U);
+  }
+}
+
+// handler removes registrations, including ones that are ready in the
+// same batch
+void test3() {
+  auto p1(xju::pipe(true,true));
+  auto p2(xju::pipe(true,true));
+  Reactor r;
+  std::unique_ptr<Reactor::Registration> r1;
+  std::unique_ptr<Reactor::Registration> r2;
+  size_t calls(0);
+  r1.reset(new Reactor::Registration(r,*p1.first,[&](PollInputState){
+        ++calls;
+        r2.reset();
+        r1.reset();
+      }));
+  r2.reset(new Reactor::Registration(r,*p2.first,[&](PollInputState){
+        ++calls;
+        r1.reset();
+        r2.reset();
+      }));
+  uint8_t const c('x');
+  p1.second->write(&c,1,xju::steadyNow());
+  p2.second->write(&c,1,xju::steadyNow());
+  xju::assert_equal(r.wait(xju::steadyNow()),1U);
+  xju::assert_equal(calls,1U);
+  xju::assert_equal(r.size(),0U);
+  xju::assert_equal(r.wait(xju::steadyNow()),0U);
+}
+
+// input and output on same file descriptor; small batches; handler
+// exception
+void test4() {
+  class Both : public xju::io::Input, public xju::io::Output
+  {
+  public:
+    explicit Both(int fd) noexcept: fd_(fd) {}
+    std::string str() const noexcept override { return "both"; }
+    int fileDescriptor() const noexcept override { return fd_; }
+  private:
+    int fd_;
+  };
+  auto const p1(xju::pipe_());
+  xju::AutoFd const p1r(p1.first);
+  xju::AutoFd const p1w(p1.second);
+  auto p2(xju::pipe(true,true));
+  auto p3(xju::pipe(true,true));
+
+  Reactor r(1);
+  std::vector<std::string> calls;
+  // note a pipe read end is never writable, so use the write end of p1
+  // as "both", which is writable and never readable
+  Both both(p1w.fd());
+  Reactor::Registration ri(r,(Input const&)both,[&](PollInputState){
+      calls.push_back("both readable");
+    });
+  Reactor::Registration ro(r,(Output const&)both,[&](PollOutputState){
+      calls.push_back("both writable");
+    });
+  xju::assert_equal(r.size(),1U);
+  xju::assert_equal(r.wait(xju::steadyNow()),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"both writable"}));
+  calls.clear();
+
+  Reactor::Registration r2(r,*p2.first,[&](PollInputState){
+      calls.push_back("p2 readable");
+      throw xju::Exception("p2 failed",XJU_TRACED);
+    });
+  Reactor::Registration r3(r,*p3.first,[&](PollInputState){
+      calls.push_back("p3 readable");
+      throw xju::Exception("p3 failed",XJU_TRACED);
+    });
+  xju::assert_equal(r.size(),3U);
+  uint8_t const c('x');
+  p2.second->write(&c,1,xju::steadyNow());
+  p3.second->write(&c,1,xju::steadyNow());
+  std::set<std::string> failed;
+  for(int i=0; i!=3; ++i){
+    try{
+      r.wait(xju::steadyNow());
+    }
+    catch(xju::Exception const& e){
+      failed.insert(e.cause().first);
+    }
+  }
+  xju::assert_equal(failed,std::set<std::string>({"p2 failed","p3 failed"}));
+  xju::assert_equal(calls.size(),3U);
+}
+
+// a large number of idle registrations
+void test5() {
+  std::vector<std::pair<std::unique_ptr<IStream>,
+                        std::unique_ptr<OStream> > > pipes;
+  Reactor r;
+  std::vector<std::unique_ptr<Reactor::Registration> > rs;
+  size_t calls(0);
+  for(int i=0; i!=200; ++i){
+    pipes.push_back(xju::pipe(true,true));
+    rs.push_back(std::unique_ptr<Reactor::Registration>(
+                   new Reactor::Registration(
+                     r,*pipes.back().first,[&](PollInputState){
+                       ++calls;
+                     })));
+  }
+  uint8_t const c('x');
+  pipes[100].second->write(&c,1,xju::steadyNow());
+  xju::assert_equal(r.wait(xju::steadyEternity()),1U);
+  xju::assert_equal(calls,1U);
+  rs.clear();
+}
+
+}
+}
+
+using namespace xju::io;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  test5(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
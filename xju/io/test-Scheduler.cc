@@ -0,0 +1,198 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/io/Scheduler.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/pipe.hh>
+#include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace xju
+{
+namespace io
+{
+
+// sleep, yield, exception from coroutine
+void test1() {
+  Scheduler s;
+  std::string order;
+  auto const t0(xju::steadyNow());
+  s.spawn([&](){
+      s.sleepUntil(t0+std::chrono::milliseconds(30));
+      order+="c";
+    });
+  s.spawn([&](){
+      s.sleepUntil(t0+std::chrono::milliseconds(10));
+      order+="b";
+    });
+  s.spawn([&](){
+      order+="a";
+      s.yield();
+      order+="a";
+    });
+  s.spawn([&](){
+      order+="x";
+      s.yield();
+      order+="x";
+    });
+  xju::assert_equal(s.size(),4U);
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+  xju::assert_equal(order,"axaxbc");
+  xju::assert_greater_equal(xju::steadyNow(),t0+std::chrono::milliseconds(30));
+
+  // run returns at deadline
+  s.spawn([&](){
+      s.sleepUntil(xju::steadyEternity());
+    });
+  xju::assert_equal(
+    s.run(xju::steadyNow()+std::chrono::milliseconds(10)),1U);
+
+  s.spawn([&](){
+      throw xju::Exception("fred",XJU_TRACED);
+    });
+  try{
+    s.run(xju::steadyNow()+std::chrono::milliseconds(10));
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"fred.");
+  }
+  xju::assert_equal(s.size(),1U);
+}
+
+// read, write and deadlines via pipes, with more data than a pipe
+// holds, so writer suspends waiting for reader
+void test2() {
+  Scheduler s(64*1024);
+  auto p(xju::pipe(true,true));
+  std::vector<uint8_t> x(1024*1024);
+  for(size_t i=0; i!=x.size(); ++i){
+    x[i]=i*7;
+  }
+  std::vector<uint8_t> y(x.size());
+  s.spawn([&](){
+      s.writeAll(*p.second,x.data(),x.size(),xju::steadyEternity());
+    });
+  s.spawn([&](){
+      s.readAll(*p.first,y.data(),y.size(),xju::steadyEternity());
+    });
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+  xju::assert_equal(x==y,true);
+
+  // nothing to read by deadline
+  size_t n(1);
+  s.spawn([&](){
+      n=s.read(*p.first,y.data(),1,
+               xju::steadyNow()+std::chrono::milliseconds(10));
+    });
+  s.run(xju::steadyEternity());
+  xju::assert_equal(n,0U);
+
+  // partial read by deadline
+  s.spawn([&](){
+      s.writeAll(*p.second,"ab",2,xju::steadyEternity());
+    });
+  s.spawn([&](){
+      try{
+        s.readAll(*p.first,y.data(),3,
+                  xju::steadyNow()+std::chrono::milliseconds(10));
+        xju::assert_never_reached();
+      }
+      catch(xju::DeadlineReached const& e){
+        xju::assert_equal(
+          readableRepr(e),
+          "Failed to read 1 more bytes, having read 2, from "+
+          p.first->str()+" by deadline because\ndeadline reached.");
+      }
+    });
+  s.run(xju::steadyEternity());
+
+  // end of input
+  s.spawn([&](){
+      p.second.reset();
+      try{
+        s.read(*p.first,y.data(),1,xju::steadyEternity());
+        xju::assert_never_reached();
+      }
+      catch(xju::io::Input::Closed const&){
+        n=99;
+      }
+    });
+  s.run(xju::steadyEternity());
+  xju::assert_equal(n,99U);
+}
+
+struct Flag
+{
+  bool& x_;
+  explicit Flag(bool& x) noexcept:
+      x_(x)
+  {
+  }
+  ~Flag() noexcept
+  {
+    x_=true;
+  }
+};
+
+// destruction unwinds suspended coroutines, many coroutines
+void test3() {
+  auto p(xju::pipe(true,true));
+  bool unwound(false);
+  bool started(false);
+  {
+    Scheduler s;
+    s.spawn([&](){
+        Flag f(unwound);
+        uint8_t c;
+        s.read(*p.first,&c,1,xju::steadyEternity());
+        xju::assert_never_reached();
+      });
+    xju::assert_equal(s.run(xju::steadyNow()),1U);
+    s.spawn([&](){
+        started=true;
+      });
+  }
+  xju::assert_equal(unwound,true);
+  xju::assert_equal(started,false);
+
+  Scheduler s(16*1024);
+  size_t const N(10000);
+  size_t done(0);
+  auto const t0(xju::steadyNow());
+  for(size_t i=0; i!=N; ++i){
+    s.spawn([&,i](){
+        s.sleepUntil(t0+std::chrono::milliseconds(i%20));
+        s.yield();
+        ++done;
+      });
+  }
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+  xju::assert_equal(done,N);
+}
+
+}
+}
+
+using namespace xju::io;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,309 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/io/URing.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/pipe.hh>
+#include <xju/io/IStream.hh>
+#include <xju/io/OStream.hh>
+#include <xju/io/FileReader.hh>
+#include <xju/io/FileWriter.hh>
+#include <xju/file/read.hh>
+#include <xju/file/rm.hh>
+#include <xju/file/Mode.hh>
+#include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
+#include <xju/Thread.hh>
+#include <xju/ip/TCPService.hh>
+#include <xju/ip/TCPSocket.hh>
+#include <xju/ip/v4/getHostAddresses.hh>
+#include <xju/getHostName.hh>
+#include <xju/AutoFd.hh>
+#include <sys/socket.h>
+#include <vector>
+#include <string>
+#include <thread>
+#include <errno.h>
+
+namespace xju
+{
+namespace io
+{
+
+// pipe read/write, deadlines
+void test1(bool forceFallback) {
+  URing r(4,16,forceFallback);
+  auto p(xju::pipe(true,true));
+
+  // nothing outstanding
+  xju::assert_equal(r.run(xju::steadyNow()),0U);
+
+  std::vector<int> results;
+  std::vector<uint8_t> b(10,0);
+  r.read(*p.first,b.data(),b.size(),-1,[&](int n){
+      results.push_back(n);
+    });
+  xju::assert_equal(r.outstanding(),1U);
+  {
+    auto const t1(xju::steadyNow());
+    xju::assert_equal(r.run(t1+std::chrono::milliseconds(100)),0U);
+    auto const t2(xju::steadyNow());
+    xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(100));
+    xju::assert_less(t2-t1,std::chrono::milliseconds(200));
+  }
+  std::string const fred("fred");
+  r.write(*p.second,fred.data(),fred.size(),-1,[&](int n){
+      results.push_back(n);
+    });
+  size_t n(0);
+  while(n!=2){
+    auto const m(r.run(xju::steadyNow()+std::chrono::seconds(1)));
+    xju::assert_greater(m,0U);
+    n+=m;
+  }
+  std::sort(results.begin(),results.end());
+  xju::assert_equal(results,std::vector<int>({4,4}));
+  xju::assert_equal(std::string(b.begin(),b.begin()+4),fred);
+  xju::assert_equal(r.outstanding(),0U);
+
+  // data arrives before deadline
+  results.clear();
+  {
+    auto const t1(xju::steadyNow());
+    r.read(*p.first,b.data(),b.size(),-1,[&](int n){
+        results.push_back(n);
+      });
+    xju::Thread th([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        p.second->write(fred.data(),fred.size(),xju::steadyNow());
+      });
+    xju::assert_equal(r.run(t1+std::chrono::seconds(1)),1U);
+    auto const t2(xju::steadyNow());
+    xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(50));
+    xju::assert_less(t2-t1,std::chrono::milliseconds(500));
+    xju::assert_equal(results,std::vector<int>({4}));
+  }
+
+  // operation deadline
+  results.clear();
+  {
+    auto const t1(xju::steadyNow());
+    r.read(*p.first,b.data(),b.size(),-1,[&](int n){
+        results.push_back(n);
+      },
+      t1+std::chrono::milliseconds(100));
+    xju::assert_equal(r.run(t1+std::chrono::seconds(1)),1U);
+    auto const t2(xju::steadyNow());
+    xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(100));
+    xju::assert_less(t2-t1,std::chrono::milliseconds(500));
+    xju::assert_equal(results,std::vector<int>({-ECANCELED}));
+  }
+
+  // end of input
+  results.clear();
+  p.second.reset();
+  r.read(*p.first,b.data(),b.size(),-1,[&](int n){
+      results.push_back(n);
+    });
+  xju::assert_equal(r.run(xju::steadyNow()+std::chrono::seconds(1)),1U);
+  xju::assert_equal(results,std::vector<int>({0}));
+}
+
+// files: positional write, fsync, registered file and buffers, more
+// operations than entries
+void test2(bool forceFallback) {
+  URing r(4,16,forceFallback);
+  auto const fileName(xju::path::split("test-URing.txt"));
+  try{
+    xju::file::rm(fileName);
+  }
+  catch(xju::Exception const&){
+  }
+  {
+    FileWriter w(fileName,xju::file::Mode(0666));
+    URing::Registration rw(r,w);
+    std::vector<std::string> const x({"aa","bb","cc","dd","ee","ff","gg"});
+    std::vector<int> results;
+    for(size_t i=0; i!=x.size(); ++i){
+      r.write(w,x[i].data(),2,i*2,[&](int n){ results.push_back(n); });
+    }
+    while(results.size()!=x.size()){
+      xju::assert_greater(r.run(xju::steadyNow()+std::chrono::seconds(1)),0U);
+    }
+    xju::assert_equal(results,std::vector<int>(x.size(),2));
+    results.clear();
+    r.fsync(w,true,[&](int n){ results.push_back(n); });
+    xju::assert_equal(r.run(xju::steadyNow()+std::chrono::seconds(1)),1U);
+    xju::assert_equal(results,std::vector<int>({0}));
+  }
+  xju::assert_equal(xju::file::read(fileName),
+                    std::string("aabbccddeeffgg"));
+  {
+    FileReader f(fileName);
+    URing::Registration rf(r,f);
+    std::vector<uint8_t> b1(8,0);
+    std::vector<uint8_t> b2(8,0);
+    r.registerBuffers({{b1.data(),b1.size()},{b2.data(),b2.size()}});
+    std::vector<int> results;
+    r.readFixed(f,1,2,4,6,[&](int n){ results.push_back(n); });
+    xju::assert_equal(r.run(xju::steadyNow()+std::chrono::seconds(1)),1U);
+    xju::assert_equal(results,std::vector<int>({4}));
+    xju::assert_equal(std::string(b2.begin()+2,b2.begin()+6),
+                      std::string("ddee"));
+    r.registerBuffers({});
+  }
+  xju::file::rm(fileName);
+}
+
+// exception from Completion
+void test3(bool forceFallback) {
+  URing r(4,16,forceFallback);
+  auto p(xju::pipe(true,true));
+  std::string const fred("fred");
+  int calls(0);
+  r.write(*p.second,fred.data(),2,-1,[&](int n){
+      ++calls;
+      throw xju::Exception("fred",XJU_TRACED);
+    });
+  r.write(*p.second,fred.data()+2,2,-1,[&](int n){
+      ++calls;
+      throw xju::Exception("fred",XJU_TRACED);
+    });
+  for(int i=0; i!=2; ++i){
+    try{
+      r.run(xju::steadyNow()+std::chrono::seconds(1));
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(e.cause().first,std::string("fred"));
+    }
+  }
+  xju::assert_equal(calls,2);
+  xju::assert_equal(r.outstanding(),0U);
+}
+
+// accept, send, recv
+void test4(bool forceFallback) {
+  URing r(4,16,forceFallback);
+  xju::ip::TCPService s(xju::ip::TCPService::Backlog(1),true);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  xju::Thread t([&](){
+      xju::ip::TCPSocket c(
+        {xju::ip::v4::getHostAddresses(xju::getHostName())[0],s.port()},
+        deadline);
+      char a;
+      c.read(&a,sizeof(a),deadline);
+      ++a;
+      c.write(&a,sizeof(a),deadline);
+    });
+  int fd(-1);
+  r.accept(s,[&](int n){ fd=n; });
+  xju::assert_equal(r.run(deadline),1U);
+  xju::assert_greater_equal(fd,0);
+  xju::AutoFd const conn(fd);
+
+  class Conn : public xju::io::Input, public xju::io::Output
+  {
+  public:
+    explicit Conn(int fd) noexcept: fd_(fd) {}
+    std::string str() const noexcept override { return "connection"; }
+    int fileDescriptor() const noexcept override { return fd_; }
+  private:
+    int fd_;
+  };
+  Conn c(conn.fd());
+  char b('x');
+  std::vector<int> results;
+  r.send(c,&b,sizeof(b),0,[&](int n){ results.push_back(n); });
+  xju::assert_equal(r.run(deadline),1U);
+  r.recv(c,&b,sizeof(b),0,[&](int n){ results.push_back(n); });
+  xju::assert_equal(r.run(deadline),1U);
+  xju::assert_equal(results,std::vector<int>({1,1}));
+  xju::assert_equal(b,'y');
+}
+
+
+// blocking file descriptors do not block run()
+void test5(bool forceFallback) {
+  URing r(4,16,forceFallback);
+  int fds[2];
+  xju::assert_equal(::pipe(fds),0);
+  xju::AutoFd const rfd(fds[0]);
+  xju::AutoFd const wfd(fds[1]);
+  class Fd : public xju::io::Input, public xju::io::Output
+  {
+  public:
+    explicit Fd(int fd) noexcept: fd_(fd) {}
+    std::string str() const noexcept override { return "blocking pipe"; }
+    int fileDescriptor() const noexcept override { return fd_; }
+  private:
+    int fd_;
+  };
+  Fd in(rfd.fd());
+  Fd out(wfd.fd());
+  std::vector<int> results;
+  std::vector<uint8_t> b(10,0);
+  auto const t1(xju::steadyNow());
+  r.read(in,b.data(),b.size(),-1,[&](int n){
+      results.push_back(n);
+    },
+    t1+std::chrono::milliseconds(100));
+  xju::assert_equal(r.run(t1+std::chrono::seconds(1)),1U);
+  auto const t2(xju::steadyNow());
+  xju::assert_less(t2-t1,std::chrono::milliseconds(500));
+  xju::assert_equal(results,std::vector<int>({-ECANCELED}));
+
+  // fsync alongside read of data arriving later
+  auto const fileName(xju::path::split("test-URing.5"));
+  {
+    FileWriter w(fileName,xju::file::Mode(0666));
+    results.clear();
+    r.fsync(w,false,[&](int n){ results.push_back(n); });
+    r.read(in,b.data(),b.size(),-1,[&](int n){ results.push_back(n); });
+    xju::Thread th([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        xju::assert_equal(::write(wfd.fd(),"fred",4),4);
+      });
+    size_t n(0);
+    while(n!=2){
+      auto const m(r.run(xju::steadyNow()+std::chrono::seconds(1)));
+      xju::assert_greater(m,0U);
+      n+=m;
+    }
+    std::sort(results.begin(),results.end());
+    xju::assert_equal(results,std::vector<int>({0,4}));
+  }
+  xju::file::rm(fileName);
+}
+
+}
+}
+
+using namespace xju::io;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  {
+    URing r;
+    std::cout << "io_uring " << (r.usingIoUring()?"":"not ")
+              << "available" << std::endl;
+  }
+  for(bool forceFallback: {false,true}){
+    test1(forceFallback), ++n;
+    test2(forceFallback), ++n;
+    test3(forceFallback), ++n;
+    test4(forceFallback), ++n;
+    test5(forceFallback), ++n;
+  }
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
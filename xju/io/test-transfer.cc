@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/io/transfer.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/pipe.hh>
+#include <xju/io/IStream.hh>
+#include <xju/file/write.hh>
+#include <xju/file/read.hh>
+#include <xju/file/rm.hh>
+#include <xju/file/Mode.hh>
+#include <xju/AutoFd.hh>
+#include <xju/steadyNow.hh>
+#include <xju/Thread.hh>
+#include <xju/ip/TCPService.hh>
+#include <xju/ip/TCPSocket.hh>
+#include <xju/ip/v4/getHostAddresses.hh>
+#include <xju/getHostName.hh>
+#include <fcntl.h>
+#include <string>
+#include <vector>
+
+namespace xju
+{
+namespace io
+{
+
+// file to pipe, offset, end of file, deadline
+void test1() {
+  auto const fileName(xju::path::split("test-transfer.txt"));
+  std::string const content("abcdefghij");
+  xju::file::write(fileName,content.data(),content.size(),
+                   xju::file::Mode(0666));
+  FileReader f(fileName);
+  auto p(xju::pipe(true,true));
+  xju::assert_equal(transfer(f,*p.second,2,5,xju::steadyNow()),5U);
+  std::vector<char> b(20,0);
+  xju::assert_equal(p.first->read(b.data(),b.size(),xju::steadyNow()),5U);
+  xju::assert_equal(std::string(b.data(),5),std::string("cdefg"));
+  // read pointer unchanged
+  xju::assert_equal(f.seekBy(0),0);
+
+  // end of file
+  xju::assert_equal(transfer(f,*p.second,7,100,xju::steadyNow()),3U);
+  xju::assert_equal(p.first->read(b.data(),b.size(),xju::steadyNow()),3U);
+  xju::assert_equal(std::string(b.data(),3),std::string("hij"));
+  xju::assert_equal(transfer(f,*p.second,10,100,xju::steadyNow()),0U);
+  xju::file::rm(fileName);
+
+  // deadline, pipe fills
+  std::string const big(1024*1024,'x');
+  xju::file::write(fileName,big.data(),big.size(),xju::file::Mode(0666));
+  FileReader g(fileName);
+  auto const t1(xju::steadyNow());
+  auto const n(transfer(g,*p.second,0,big.size(),
+                        t1+std::chrono::milliseconds(100)));
+  auto const t2(xju::steadyNow());
+  xju::assert_greater(n,0U);
+  xju::assert_less(n,big.size());
+  xju::assert_greater_equal(t2-t1,std::chrono::milliseconds(100));
+  xju::assert_less(t2-t1,std::chrono::milliseconds(300));
+  xju::file::rm(fileName);
+}
+
+// output that does not support sendfile (append mode), so falls back
+void test2() {
+  auto const fileName(xju::path::split("test-transfer.txt"));
+  auto const outName(xju::path::split("test-transfer.out"));
+  std::string const content("abcdefghij");
+  xju::file::write(fileName,content.data(),content.size(),
+                   xju::file::Mode(0666));
+  xju::file::write(outName,"x",1,xju::file::Mode(0666));
+  {
+    class Appender : public OStream
+    {
+    public:
+      explicit Appender(std::string const& fileName):
+          fd_(::open(fileName.c_str(),O_WRONLY|O_APPEND|O_CLOEXEC))
+      {
+      }
+      std::string str() const noexcept override { return "appender"; }
+      int fileDescriptor() const noexcept override { return fd_.fd(); }
+    private:
+      xju::AutoFd const fd_;
+    };
+    FileReader f(fileName);
+    Appender a(xju::path::str(outName));
+    xju::assert_equal(transfer(f,a,1,8,xju::steadyNow()),8U);
+    xju::assert_equal(transfer(f,a,9,8,xju::steadyNow()),1U);
+  }
+  xju::assert_equal(xju::file::read(outName),std::string("xbcdefghij"));
+  xju::file::rm(fileName);
+  xju::file::rm(outName);
+}
+
+// file to TCP socket
+void test3() {
+  auto const fileName(xju::path::split("test-transfer.txt"));
+  std::string content;
+  for(int i=0; content.size()<3*1024*1024; ++i){
+    content+=std::to_string(i);
+  }
+  xju::file::write(fileName,content.data(),content.size(),
+                   xju::file::Mode(0666));
+  xju::ip::TCPService s(xju::ip::TCPService::Backlog(1),true);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(10));
+  std::string received(content.size()-100,0);
+  {
+    xju::Thread t([&](){
+        xju::ip::TCPSocket c(
+          {xju::ip::v4::getHostAddresses(xju::getHostName())[0],s.port()},
+          deadline);
+        c.readAll(&received[0],received.size(),deadline);
+      });
+    xju::ip::TCPSocket x(s,deadline);
+    FileReader f(fileName);
+    xju::assert_equal(transfer(f,x,100,received.size(),deadline),
+                      received.size());
+  }
+  xju::assert_equal(received,content.substr(100));
+  xju::file::rm(fileName);
+}
+
+}
+}
+
+using namespace xju::io;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -21,6 +21,13 @@
 #include <xju/stringToDouble.hh>
 #include <xju/ip/v4/Header.hh>
 #include <xju/ip/icmp/encodeDestinationUnreachable.hh>
+#include <xju/ip/icmp/decodeEcho.hh>
+#include <xju/Mutex.hh>
+#include <xju/Condition.hh>
+#include <xju/Lock.hh>
+#include <deque>
+#include <map>
+#include <algorithm>
 
 namespace xju
 {
@@ -50,11 +57,10 @@ public:
     std::cout << xju::format::time(xju::now())
               << " send(" << to << ", " << x << ")"<<std::endl;
       
-    calls_.enqueue(*this,
-                   &xju::ip::icmp::SocketIf::send,
-                   to,
-                   x,
-                   deadline)->awaitReturn();
+    calls_.enqueue(xju::test::callTo(*this,&xju::ip::icmp::SocketIf::send)(
+                     to,
+                     x,
+                     deadline))->awaitReturn();
   }
   std::tuple<xju::ip::v4::Address,Message> receive() /*throw(
       xju::SyscallFailed,
@@ -67,7 +73,8 @@ public:
     char c(' ');
     input_.first->read(&c,1U,xju::steadyNow());
     xju::assert_equal(c,'x');
-    return calls_.enqueue(*this,&xju::ip::icmp::SocketIf::receive)
+    return calls_.enqueue(
+      xju::test::callTo(*this,&xju::ip::icmp::SocketIf::receive)())
       ->awaitResult();
   }
   xju::test::Calls calls_;
@@ -113,40 +120,263 @@ public:
                         unsigned int retry,
                         std::chrono::nanoseconds rtt) noexcept override
   {
-    calls_.enqueue(*this,&xju::ip::icmp::Pinger::CollectorIf::pinged,
-                   address,
-                   retry,
-                   rtt)->awaitReturn();
+    calls_.enqueue(
+      xju::test::callTo(*this,&xju::ip::icmp::Pinger::CollectorIf::pinged)(
+        address,
+        retry,
+        rtt))->awaitReturn();
   }
       
   void timeout(xju::ip::v4::Address const& address) noexcept override
   {
-    calls_.enqueue(*this,&xju::ip::icmp::Pinger::CollectorIf::timeout,
-                   address)->awaitReturn();
+    calls_.enqueue(
+      xju::test::callTo(*this,&xju::ip::icmp::Pinger::CollectorIf::timeout)(
+        address))->awaitReturn();
   }
   void unreachable(xju::ip::v4::Address const& address,
                    xju::ip::v4::Address const& gatewayOrHost,
                    xju::ip::icmp::Message::Code code) noexcept override
   {
-    calls_.enqueue(*this,&xju::ip::icmp::Pinger::CollectorIf::unreachable,
-                   address,
-                   gatewayOrHost,
-                   code)->awaitReturn();
+    calls_.enqueue(
+      xju::test::callTo(*this,
+                        &xju::ip::icmp::Pinger::CollectorIf::unreachable)(
+        address,
+        gatewayOrHost,
+        code))->awaitReturn();
   }
   void sendFailed(xju::Exception const& e) noexcept override
   {
-    calls_.enqueue(*this,&xju::ip::icmp::Pinger::CollectorIf::sendFailed,
-                   e)->awaitReturn();
+    calls_.enqueue(
+      xju::test::callTo(*this,&xju::ip::icmp::Pinger::CollectorIf::sendFailed)(
+        e))->awaitReturn();
   }
   void receiveFailed(xju::Exception const& e) noexcept override
   {
-    calls_.enqueue(*this,&xju::ip::icmp::Pinger::CollectorIf::receiveFailed,
-                   e)->awaitReturn();
+    calls_.enqueue(
+      xju::test::callTo(*this,
+                        &xju::ip::icmp::Pinger::CollectorIf::receiveFailed)(
+        e))->awaitReturn();
   }
 };
   
 }
 
+// fakes that record what Pinger does, for tests that need many
+// addresses and sends
+namespace fake
+{
+
+// answers (if reply) each echo request with an echo reply, queued for
+// receiveMany(); each sendMany() takes sendDelay before transmitting
+class SocketIf : public xju::ip::icmp::SocketIf
+{
+public:
+  struct Sent
+  {
+    std::chrono::steady_clock::time_point at_;
+    xju::ip::v4::Address to_;
+    uint16_t sequence_;
+  };
+
+  explicit SocketIf(bool reply,
+                    std::chrono::steady_clock::duration sendDelay=
+                    std::chrono::milliseconds(0)) noexcept
+      :reply_(reply),
+       sendDelay_(sendDelay),
+       input_(xju::pipe(true,true))
+  {
+  }
+  void send(
+    xju::ip::v4::Address const& to,
+    Message const& x,
+    std::chrono::steady_clock::time_point const& deadline) /*throw(
+      xju::SyscallFailed,
+      xju::DeadlineReached)*/ override
+  {
+    std::pair<xju::ip::v4::Address,Message> const y(to,x);
+    sendMany(&y,1U,deadline);
+  }
+  size_t sendMany(
+    std::pair<xju::ip::v4::Address,Message> const* x,
+    size_t n,
+    std::chrono::steady_clock::time_point const& deadline) /*throw(
+      xju::SyscallFailed,
+      xju::DeadlineReached)*/ override
+  {
+    std::this_thread::sleep_for(sendDelay_);
+    xju::Lock l(guard_);
+    auto const now(xju::steadyNow());
+    bool const wasEmpty(replies_.empty());
+    sendBatches_.push_back(n);
+    for(size_t i=0; i!=n; ++i){
+      Echo const echo(decodeEcho(x[i].second.header_,x[i].second.data_));
+      sent_.push_back(Sent{now,x[i].first,uint16_t(echo.sequence_.value())});
+      if (reply_){
+        replies_.push_back(
+          Received(x[i].first,
+                   Message(Message::Type::ECHOREPLY,
+                           Message::Code(0),
+                           Checksum(0),
+                           encodeEcho(echo)),
+                   now));
+      }
+    }
+    if (wasEmpty && replies_.size()){
+      input_.second->write("x",1U,xju::steadyNow());
+    }
+    return n;
+  }
+  std::tuple<xju::ip::v4::Address,Message> receive() /*throw(
+      xju::SyscallFailed,
+      // invalid message, e.g. incorrect checksum
+      xju::Exception)*/ override
+  {
+    std::vector<Received> x;
+    receiveMany(x,1U);
+    return std::make_tuple(std::get<0>(x[0]),std::get<1>(x[0]));
+  }
+  void receiveMany(std::vector<Received>& into, size_t max) /*throw(
+      xju::SyscallFailed,
+      // invalid message, e.g. incorrect checksum
+      xju::Exception)*/ override
+  {
+    xju::Lock l(guard_);
+    size_t const n(std::min(max,replies_.size()));
+    for(size_t i=0; i!=n; ++i){
+      into.push_back(replies_.front());
+      replies_.pop_front();
+    }
+    receiveBatches_.push_back(n);
+    if (replies_.empty()){
+      char c(' ');
+      input_.first->read(&c,1U,xju::steadyNow());
+    }
+  }
+  xju::io::Input const& input() const noexcept override
+  {
+    return *input_.first;
+  }
+
+  std::vector<Sent> sent() const noexcept
+  {
+    xju::Lock l(guard_);
+    return sent_;
+  }
+  std::vector<size_t> sendBatches() const noexcept
+  {
+    xju::Lock l(guard_);
+    return sendBatches_;
+  }
+  std::vector<size_t> receiveBatches() const noexcept
+  {
+    xju::Lock l(guard_);
+    return receiveBatches_;
+  }
+
+private:
+  bool const reply_;
+  std::chrono::steady_clock::duration const sendDelay_;
+  std::pair<std::unique_ptr<xju::io::IStream>,
+            std::unique_ptr<xju::io::OStream> > input_;
+
+  mutable xju::Mutex guard_;
+  std::vector<Sent> sent_;
+  std::vector<size_t> sendBatches_;
+  std::vector<size_t> receiveBatches_;
+  // input_ is readable iff non-empty
+  std::deque<Received> replies_;
+};
+
+class CollectorIf : public xju::ip::icmp::Pinger::CollectorIf
+{
+public:
+  CollectorIf() noexcept:
+      changed_(guard_)
+  {
+  }
+
+  void pinged(xju::ip::v4::Address const& address,
+              unsigned int retry,
+              std::chrono::nanoseconds rtt) noexcept override
+  {
+    xju::Lock l(guard_);
+    pinged_.push_back(std::make_pair(address,retry));
+    rtts_.push_back(rtt);
+    changed_.signal(l);
+  }
+  void timeout(xju::ip::v4::Address const& address) noexcept override
+  {
+    xju::Lock l(guard_);
+    timedOut_.insert(std::make_pair(address,xju::steadyNow()));
+    changed_.signal(l);
+  }
+  void unreachable(xju::ip::v4::Address const& address,
+                   xju::ip::v4::Address const& gatewayOrHost,
+                   xju::ip::icmp::Message::Code code) noexcept override
+  {
+    xju::assert_never_reached();
+  }
+  void sendFailed(xju::Exception const& e) noexcept override
+  {
+    xju::assert_never_reached();
+  }
+  void receiveFailed(xju::Exception const& e) noexcept override
+  {
+    xju::assert_never_reached();
+  }
+
+  std::vector<std::pair<xju::ip::v4::Address,unsigned int> > pinged() const
+    noexcept
+  {
+    xju::Lock l(guard_);
+    return pinged_;
+  }
+
+  // wait until n pings have been reported, or deadline
+  // - returns round trip time of each
+  std::vector<std::chrono::nanoseconds> awaitPinged(
+    size_t n,std::chrono::steady_clock::time_point deadline) noexcept
+  {
+    xju::Lock l(guard_);
+    while(rtts_.size()<n && xju::steadyNow()<deadline){
+      changed_.wait(l,deadline);
+    }
+    return rtts_;
+  }
+
+  // wait until n addresses have timed out, or deadline
+  // - returns address -> time of (first) timeout
+  std::map<xju::ip::v4::Address,std::chrono::steady_clock::time_point>
+  awaitTimeouts(size_t n,std::chrono::steady_clock::time_point deadline)
+    noexcept
+  {
+    xju::Lock l(guard_);
+    while(timedOut_.size()<n && xju::steadyNow()<deadline){
+      changed_.wait(l,deadline);
+    }
+    return timedOut_;
+  }
+
+private:
+  mutable xju::Mutex guard_;
+  xju::Condition changed_;
+  std::vector<std::pair<xju::ip::v4::Address,unsigned int> > pinged_;
+  std::vector<std::chrono::nanoseconds> rtts_;
+  std::map<xju::ip::v4::Address,std::chrono::steady_clock::time_point>
+    timedOut_;
+};
+
+std::set<xju::ip::v4::Address> addresses(size_t n) noexcept
+{
+  std::set<xju::ip::v4::Address> result;
+  for(uint32_t i=0; i!=n; ++i){
+    result.insert(xju::ip::v4::Address((10U<<24)|(i+1)));
+  }
+  return result;
+}
+
+}
+
 void test1(double rate) {
             
   std::chrono::nanoseconds const step{(long)(1e9/rate)};
@@ -569,6 +799,162 @@ void test3(double rate) {
   }
 }
 
+// pacing: sends never exceed the token bucket (one token to start,
+// refilled at rate)
+void test4() {
+  double const rate(1000.0);
+  fake::SocketIf socket(false);
+  fake::CollectorIf collector;
+  xju::ip::icmp::Echo::Identifier identifier{0xfedc};
+  Pinger p{socket,
+           collector,
+           identifier,
+           Echo::Sequence(5),
+           fake::addresses(5000),
+           rate,
+           0,
+           std::chrono::seconds(10)};
+  auto const t0(xju::steadyNow());
+  {
+    xju::Thread t{ [&]{ p.run(); }, [&]{ p.stop(); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  }
+  auto const elapsed(xju::steadyNow()-t0);
+  auto const sent(socket.sent());
+  xju::assert_greater_equal(sent.size(),150U);
+  xju::assert_less_equal(
+    sent.size(),
+    1U+(size_t)(rate*std::chrono::duration<double>(elapsed).count()));
+  for(size_t i=0; i!=sent.size(); ++i){
+    // the i+1th send needed i tokens beyond the first
+    xju::assert_greater_equal(
+      std::chrono::duration<double>(sent[i].at_-t0).count()+1e-6,
+      i/rate);
+    // round robin, no address repeated (none timed out)
+    if (i){
+      xju::assert_greater(sent[i].to_,sent[i-1].to_);
+    }
+    xju::assert_equal(sent[i].sequence_,5U);
+  }
+}
+
+// batching: at a high rate requests due together go in one sendMany,
+// and replies arriving together are read by one receiveMany, each
+// matched to its address
+void test5() {
+  double const rate(200000.0);
+  fake::SocketIf socket(true);
+  fake::CollectorIf collector;
+  xju::ip::icmp::Echo::Identifier identifier{0xfedc};
+  auto const addresses(fake::addresses(2000));
+  Pinger p{socket,
+           collector,
+           identifier,
+           Echo::Sequence(5),
+           addresses,
+           rate,
+           0,
+           std::chrono::seconds(10)};
+  {
+    xju::Thread t{ [&]{ p.run(); }, [&]{ p.stop(); }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  auto const sendBatches(socket.sendBatches());
+  auto const receiveBatches(socket.receiveBatches());
+  xju::assert_greater(
+    *std::max_element(sendBatches.begin(),sendBatches.end()),1U);
+  xju::assert_less_equal(
+    *std::max_element(sendBatches.begin(),sendBatches.end()),64U);
+  xju::assert_greater(
+    *std::max_element(receiveBatches.begin(),receiveBatches.end()),1U);
+  xju::assert_less_equal(
+    *std::max_element(receiveBatches.begin(),receiveBatches.end()),64U);
+
+  auto const pinged(collector.pinged());
+  size_t received(0);
+  for(auto n: receiveBatches){
+    received+=n;
+  }
+  // every reply read was matched (address outstanding with that
+  // sequence)
+  xju::assert_equal(pinged.size(),received);
+  xju::assert_less_equal(pinged.size(),socket.sent().size());
+  for(auto const& x: pinged){
+    xju::assert_not_equal(addresses.find(x.first),addresses.end());
+    xju::assert_equal(x.second,0U);
+  }
+}
+
+// timeout expiry: each request is retried after timeoutPerRetry, and
+// timeout reported after the last retry times out
+void test6() {
+  fake::SocketIf socket(false);
+  fake::CollectorIf collector;
+  xju::ip::icmp::Echo::Identifier identifier{0xfedc};
+  auto const addresses(fake::addresses(3));
+  auto const timeoutPerRetry(std::chrono::milliseconds(30));
+  Pinger p{socket,
+           collector,
+           identifier,
+           Echo::Sequence(5),
+           addresses,
+           1000.0,
+           2,
+           timeoutPerRetry};
+  std::map<xju::ip::v4::Address,std::chrono::steady_clock::time_point> t;
+  {
+    xju::Thread x{ [&]{ p.run(); }, [&]{ p.stop(); }};
+    t=collector.awaitTimeouts(addresses.size(),
+                              xju::steadyNow()+std::chrono::seconds(5));
+  }
+  xju::assert_equal(t.size(),addresses.size());
+  xju::assert_equal(collector.pinged().size(),0U);
+  // allows for timer wheel resolution
+  auto const tick(std::chrono::milliseconds(1));
+  auto const sent(socket.sent());
+  for(auto a: addresses){
+    std::vector<fake::SocketIf::Sent> x;
+    std::copy_if(sent.begin(),sent.end(),std::back_inserter(x),
+                 [&](fake::SocketIf::Sent const& s){ return s.to_==a; });
+    xju::assert_greater_equal(x.size(),3U);
+    for(size_t i=1; i!=3; ++i){
+      xju::assert_equal(x[i].sequence_,x[0].sequence_+i);
+      xju::assert_greater_equal(x[i].at_-x[i-1].at_,timeoutPerRetry-tick);
+    }
+    xju::assert_greater_equal((*t.find(a)).second-x[2].at_,
+                              timeoutPerRetry-tick);
+    // next round's request only after timeout reported
+    if (x.size()>3){
+      xju::assert_greater_equal(x[3].at_,(*t.find(a)).second);
+    }
+  }
+}
+
+// round trip time excludes time spent sending
+void test7() {
+  auto const sendDelay(std::chrono::milliseconds(20));
+  fake::SocketIf socket(true,sendDelay);
+  fake::CollectorIf collector;
+  xju::ip::icmp::Echo::Identifier identifier{0xfedc};
+  Pinger p{socket,
+           collector,
+           identifier,
+           Echo::Sequence(5),
+           fake::addresses(1),
+           100.0,
+           2,
+           std::chrono::seconds(1)};
+  std::vector<std::chrono::nanoseconds> rtts;
+  {
+    xju::Thread x{ [&]{ p.run(); }, [&]{ p.stop(); }};
+    rtts=collector.awaitPinged(2,xju::steadyNow()+std::chrono::seconds(5));
+  }
+  xju::assert_greater_equal(rtts.size(),2U);
+  for(auto rtt: rtts){
+    xju::assert_less(rtt,sendDelay);
+  }
+}
+
 }
 }
 }
@@ -581,6 +967,10 @@ int main(int argc, char* argv[])
   test1(argc>1?xju::stringToDouble(argv[1]):1), ++n;
   test2(argc>1?xju::stringToDouble(argv[1]):1), ++n;
   test3(argc>1?xju::stringToDouble(argv[1]):1), ++n;
+  test4(), ++n;
+  test5(), ++n;
+  test6(), ++n;
+  test7(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
@@ -16,6 +16,8 @@
 #include <xju/io/select.hh>
 #include <xju/ip/icmp/encodeEcho.hh>
 #include <xju/ip/icmp/decodeEcho.hh>
+#include <xju/ip/timestamping.hh>
+#include <vector>
 
 namespace xju
 {
@@ -55,6 +57,77 @@ void test1() {
   }        
 }
 
+void test2() {
+  // timestamping: a queued transmit timestamp makes the socket
+  // readable, receiveMany receives nothing for it (and keeps it for
+  // getSendTimestamps) rather than failing or leaving the socket
+  // readable
+  Socket s;
+  s.enableTimestamping();
+  // localhost ignores information requests, so nothing to receive
+  Message m(Message::Type::INFO_REQUEST,
+            Message::Code(0),
+            Checksum(0),
+            {0,0,0,1},
+            {});
+  xju::ip::v4::Address localHost{(127U<<24)+(0U<<16)+(0U<<8)+1U};
+  s.send(localHost,m,xju::steadyNow()+std::chrono::seconds(10));
+  std::vector<SocketIf::Received> received;
+  int readable(0);
+  while(xju::io::select({&s.input()},
+                        xju::steadyNow()+std::chrono::milliseconds(200))
+        .size()){
+    s.receiveMany(received,8);
+    xju::assert_less(++readable,10);
+  }
+  auto const sent{s.getSendTimestamps()};
+  xju::assert_equal(sent.size(),1U);
+  xju::assert_equal(sent[0].id_,0U);
+  xju::assert_equal(sent[0].at_.software_.valid(),true);
+}
+
+void test3() {
+  // sendMany, twice so that second reuses (shorter) buffers of first
+  Socket s;
+  auto const pid{getpid()};
+  xju::ip::v4::Address localHost{(127U<<24)+(0U<<16)+(0U<<8)+1U};
+  auto const deadline{xju::steadyNow()+std::chrono::seconds(10)};
+  std::vector<Echo> expected;
+  for(auto const& payload: std::vector<std::vector<uint8_t> >(
+        {{1,2,3,4,5,6,7,8},{9}})){
+    std::vector<std::pair<xju::ip::v4::Address,Message> > x;
+    for(uint16_t i=0; i!=3; ++i){
+      Echo const e{Echo::Identifier(pid),
+                   Echo::Sequence(expected.size()+10),
+                   payload};
+      expected.push_back(e);
+      x.push_back({localHost,Message(Message::Type::ECHO,
+                                     Message::Code(0),
+                                     Checksum(0),
+                                     encodeEcho(e))});
+    }
+    xju::assert_equal(s.sendMany(x.data(),x.size(),deadline),3U);
+  }
+  std::vector<Echo> replies;
+  while(replies.size()!=expected.size()){
+    xju::assert_not_equal(
+      xju::io::select({&s.input()},deadline).size(),0U);
+    std::vector<SocketIf::Received> received;
+    s.receiveMany(received,8);
+    for(auto const& r: received){
+      if (std::get<0>(r)==localHost &&
+          std::get<1>(r).type_==Message::Type::ECHOREPLY){
+        auto const er{decodeEcho(std::get<1>(r).header_,
+                                 std::get<1>(r).data_)};
+        if (er.identifier_==Echo::Identifier(pid)){
+          replies.push_back(er);
+        }
+      }
+    }
+  }
+  xju::assert_equal(replies,expected);
+}
+
 }
 }
 }
@@ -65,6 +138,8 @@ int main(int argc, char* argv[])
 {
   unsigned int n(0);
   test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
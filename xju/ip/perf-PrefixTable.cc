@@ -0,0 +1,170 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// Memory and lookup rate of PrefixTable over synthetic routing-table
+// sized sets of prefixes (IPv4 lengths distributed as in the global
+// routing table, mostly /24, IPv6 mostly /48), looking up addresses
+// within the prefixes:
+//   - single lookups
+//   - batch lookups
+//   - longest-match search of a std::map of prefixes (one find per
+//     prefix length), as done before PrefixTable
+//
+#include <xju/ip/PrefixTable.hh>
+
+#include <iostream>
+#include <chrono>
+#include <map>
+#include <random>
+#include <vector>
+#include <xju/assert.hh>
+
+namespace xju
+{
+namespace ip
+{
+
+template<class Address, class Prefix>
+void run(std::string const& name,
+         std::vector<std::pair<Prefix,uint32_t> > const& prefixes,
+         std::vector<Address> const& addresses,
+         size_t const repeats)
+{
+  auto const t0(std::chrono::steady_clock::now());
+  PrefixTable<Address,uint32_t> const t(prefixes);
+  auto const t1(std::chrono::steady_clock::now());
+  std::cout << name << ": " << t.size() << " prefixes, built in "
+            << std::chrono::duration<double>(t1-t0).count() << "s, "
+            << t.bytes()/1e6 << "MB ("
+            << (double)t.bytes()/t.size() << " bytes/prefix)" << std::endl;
+
+  size_t const n(addresses.size()*repeats);
+  uint64_t single(0);
+  {
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t r=0; r!=repeats; ++r){
+      for(auto const& a: addresses){
+        uint32_t const* const x(t.lookup(a));
+        single+=x?*x:0;
+      }
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    std::cout << "  single: "
+              << n/std::chrono::duration<double>(t2-t1).count()/1e6
+              << "M lookups/s" << std::endl;
+  }
+  {
+    uint64_t batch(0);
+    std::vector<uint32_t const*> results(addresses.size());
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t r=0; r!=repeats; ++r){
+      t.lookup(addresses.data(),addresses.size(),results.data());
+      for(auto x: results){
+        batch+=x?*x:0;
+      }
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    std::cout << "  batch: "
+              << n/std::chrono::duration<double>(t2-t1).count()/1e6
+              << "M lookups/s" << std::endl;
+    xju::assert_equal(batch,single);
+  }
+  {
+    std::map<Prefix,uint32_t> const m(prefixes.begin(),prefixes.end());
+    unsigned int const bits(sizeof(Address)==4?32:128);
+    size_t const k(std::min(addresses.size(),(size_t)100000));
+    uint64_t total(0);
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t i=0; i!=k; ++i){
+      for(int l=bits; l>=0; --l){
+        auto const j(m.find(Prefix(addresses[i],l)));
+        if (j!=m.end()){
+          total+=j->second;
+          break;
+        }
+      }
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    std::cout << "  std::map: "
+              << k/std::chrono::duration<double>(t2-t1).count()/1e6
+              << "M lookups/s" << std::endl;
+  }
+}
+
+template<class Random>
+unsigned int v4Length(Random& r)
+{
+  unsigned int const x(r()%100);
+  return x<55?24:x<65?23:x<75?22:x<83?21:x<90?20:x<95?16+r()%4:
+    x<98?8+r()%8:25+r()%8;
+}
+
+template<class Random>
+unsigned int v6Length(Random& r)
+{
+  unsigned int const x(r()%100);
+  return x<50?48:x<70?32+r()%16:x<90?29+r()%4:49+r()%16;
+}
+
+v6::Address v6Address(uint64_t const hi, uint64_t const lo)
+{
+  v6::Address result;
+  for(size_t i=0; i!=8; ++i){
+    result[i]=hi>>(56-8*i);
+    result[8+i]=lo>>(56-8*i);
+  }
+  return result;
+}
+
+}
+}
+
+using namespace xju::ip;
+
+int main(int argc, char* argv[])
+{
+  std::mt19937_64 r(1);
+  {
+    std::vector<std::pair<v4::Prefix,uint32_t> > prefixes;
+    for(uint32_t i=0; i!=900000; ++i){
+      v4::Address const a(0x01000000+r()%0xdf000000);
+      prefixes.push_back({v4::Prefix(a,v4Length(r)),i});
+    }
+    std::vector<v4::Address> addresses;
+    for(uint32_t i=0; i!=1000000; ++i){
+      auto const& p(prefixes[r()%prefixes.size()].first);
+      addresses.push_back(
+        v4::Address(p.address().value()|
+                    (r()&(p.length()?~(~0U<<(32-p.length())):~0U))));
+    }
+    run("IPv4",prefixes,addresses,20);
+  }
+  {
+    std::vector<std::pair<v6::Prefix,uint32_t> > prefixes;
+    for(uint32_t i=0; i!=200000; ++i){
+      // within 2000::/4, as allocated
+      prefixes.push_back({v6::Prefix(v6Address(0x2000000000000000ULL|
+                                               (r()>>4),0),
+                                     v6Length(r)),i});
+    }
+    std::vector<v6::Address> addresses;
+    for(uint32_t i=0; i!=1000000; ++i){
+      auto const& p(prefixes[r()%prefixes.size()].first);
+      uint64_t hi(0);
+      for(size_t j=0; j!=8; ++j){
+        hi=(hi<<8)|p.address()[j];
+      }
+      // (all prefixes are at most /64)
+      addresses.push_back(
+        v6Address(hi|(r()&~(~0ULL<<(64-p.length()))),r()));
+    }
+    run("IPv6",prefixes,addresses,10);
+  }
+  return 0;
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// IP checksum throughput for header, MTU, jumbo and GSO sized data,
+// compared with byte-at-a-time calculation via decode::Iterator; and
+// incremental update of a header checksum compared with recalculation.
+//
+#include <xju/ip/checksum/calculate.hh>
+#include <xju/ip/checksum/update.hh>
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <xju/assert.hh>
+#include <xju/ip/decode.hh>
+
+namespace xju
+{
+namespace ip
+{
+namespace checksum
+{
+
+// calculate as it was before word-at-a-time sums
+Checksum calculateBytewise(std::vector<uint8_t> const& x)
+{
+  auto i(xju::ip::decode::makeIterator(x.begin(),x.end()));
+  uint32_t sum = 0;
+  while( !i.atEnd() )  {
+    uint16_t x{i.get8Bits("")};
+    x<<=8;
+    if (!i.atEnd()){
+      x+=i.get8Bits("");
+    }
+    sum+=x;
+  }
+  while (sum>>16){
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+  return Checksum((uint16_t)~sum);
+}
+
+// returns MB/s
+template<class F>
+double measure(F f, std::vector<uint8_t> const& x, size_t repeat)
+{
+  Checksum const expected(f(x));
+  auto const t1(std::chrono::steady_clock::now());
+  for(size_t r=0; r!=repeat; ++r){
+    xju::assert_equal(f(x),expected);
+  }
+  auto const t2(std::chrono::steady_clock::now());
+  double const seconds(std::chrono::duration<double>(t2-t1).count());
+  return (x.size()*repeat)/seconds/1e6;
+}
+
+}
+}
+}
+
+using namespace xju::ip::checksum;
+
+int main(int argc, char* argv[])
+{
+  size_t const total((argc>1?std::stoul(argv[1]):256)*1024*1024);
+  for(size_t size: {20U,64U,1500U,9000U,65536U}){
+    std::vector<uint8_t> x(size);
+    for(size_t i=0; i!=size; ++i){
+      x[i]=i*7+3;
+    }
+    size_t const repeat(total/size);
+    xju::assert_equal(calculateBytewise(x),calculate(x.data(),x.size()));
+    double const fast(
+      measure([](std::vector<uint8_t> const& x){
+          return calculate(xju::ip::decode::makeIterator(x.begin(),x.end()));
+        },x,repeat));
+    double const slow(measure(calculateBytewise,x,repeat/8+1));
+    std::cout << size << "-byte data, " << repeat << " times" << std::endl
+              << "  calculate:      " << fast << "MB/s" << std::endl
+              << "  byte-at-a-time: " << slow << "MB/s" << std::endl
+              << "  ratio: " << (fast/slow) << std::endl;
+  }
+  {
+    // rewrite ttl of a 20-byte header
+    std::vector<uint8_t> x{
+      0x45, 0x00, 0x00, 0x54, 0xbb, 0xdb, 0x40, 0x00, 0x40, 0x01,
+      0x00, 0x00, 0xc0, 0xa8, 0x00, 0x03, 0xc0, 0xa8, 0x00, 0x01};
+    size_t const n(10*1000*1000);
+    xju::ip::Checksum c(calculate(x.data(),x.size()));
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t i=0; i!=n; ++i){
+      uint16_t const from((x[8]<<8)+x[9]);
+      --x[8];
+      c=update(c,from,(uint16_t)((x[8]<<8)+x[9]));
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    xju::assert_equal(c,calculate(x.data(),x.size()));
+    for(size_t i=0; i!=n; ++i){
+      --x[8];
+      c=calculate(x.data(),x.size());
+    }
+    auto const t3(std::chrono::steady_clock::now());
+    xju::assert_equal(c,calculate(x.data(),x.size()));
+    double const u(std::chrono::duration<double>(t2-t1).count()*1e9/n);
+    double const r(std::chrono::duration<double>(t3-t2).count()*1e9/n);
+    std::cout << "20-byte header ttl rewrite, " << n << " times" << std::endl
+              << "  update:      " << u << "ns" << std::endl
+              << "  recalculate: " << r << "ns" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/ip/ConnectionPool.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/steadyNow.hh>
+#include <xju/Thread.hh>
+#include <xju/ip/TCPService.hh>
+#include <xju/ip/v4/getHostAddresses.hh>
+#include <xju/getHostName.hh>
+#include <xju/format.hh>
+#include <memory>
+#include <vector>
+#include <thread>
+
+namespace xju
+{
+namespace ip
+{
+
+// reuse, unhealthy, discard, expiry
+void test1() {
+  TCPService service(TCPService::Backlog(16),true);
+  std::vector<std::unique_ptr<TCPSocket>> server;
+  ConnectionPool<>::Endpoint const endpoint(
+    xju::ip::v4::getHostAddresses(xju::getHostName())[0],service.port());
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  ConnectionPool<> p(2,1,std::chrono::milliseconds(200));
+
+  auto c0(p.checkout(endpoint,deadline));
+  auto local(c0->localAddress());
+  c0.done();
+  {
+    auto c(p.checkout(endpoint,deadline));
+    xju::assert_equal(c->localAddress(),local);
+    c.done();
+  }
+  xju::assert_equal(p.stats().connects_,1U);
+  xju::assert_equal(p.stats().reuses_,1U);
+  xju::assert_equal(p.stats().idle_,1U);
+
+  // peer closes idle connection
+  for(auto& s: service.acceptPending(16)){
+    server.push_back(std::move(s));
+  }
+  xju::assert_equal(server.size(),1U);
+  server.clear();
+  {
+    auto c(p.checkout(endpoint,deadline));
+    xju::assert_not_equal(c->localAddress(),local);
+    local=c->localAddress();
+    c.done();
+  }
+  xju::assert_equal(p.stats().unhealthy_,1U);
+  xju::assert_equal(p.stats().connects_,2U);
+
+  // not done, so closed
+  p.checkout(endpoint,deadline);
+  xju::assert_equal(p.stats().discards_,1U);
+  xju::assert_equal(p.stats().open_,0U);
+
+  // expiry
+  {
+    auto c(p.checkout(endpoint,deadline));
+    c.done();
+  }
+  xju::assert_equal(p.purge(),0U);
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  xju::assert_equal(p.purge(),1U);
+  xju::assert_equal(p.stats().open_,0U);
+  std::cout << p.stats() << std::endl;
+}
+
+// per-endpoint limit, warming
+void test2() {
+  TCPService service(TCPService::Backlog(16),true);
+  ConnectionPool<>::Endpoint const endpoint(
+    xju::ip::v4::getHostAddresses(xju::getHostName())[0],service.port());
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  ConnectionPool<> p(2,2,std::chrono::seconds(10));
+
+  xju::assert_equal(p.warm(endpoint,3,deadline),2U);
+  xju::assert_equal(p.warm(endpoint,3,deadline),0U);
+  xju::assert_equal(p.stats().idle_,2U);
+
+  auto c1(p.checkout(endpoint,deadline));
+  auto c2(p.checkout(endpoint,deadline));
+  xju::assert_equal(p.stats().reuses_,2U);
+  try{
+    p.checkout(endpoint,xju::steadyNow()+std::chrono::milliseconds(10));
+    xju::assert_never_reached();
+  }
+  catch(xju::DeadlineReached const& e){
+    xju::assert_equal(readableRepr(e),"Failed to check out connection to host "+xju::format::str(endpoint.first)+" port "+xju::format::str(endpoint.second)+" from pool by deadline because\ndeadline reached with all 2 connections in use.");
+  }
+  // waiter gets connection when another thread finishes with one
+  xju::Thread t([&](){
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      c1.done();
+    });
+  auto c3(p.checkout(endpoint,deadline));
+  xju::assert_greater_equal(p.stats().waits_,2U);
+  xju::assert_equal(p.stats().connects_,2U);
+  c2.done();
+  c3.done();
+}
+
+// connect failure releases its slot
+void test3() {
+  // (port no longer listened on)
+  ConnectionPool<>::Endpoint const endpoint(
+    xju::ip::v4::getHostAddresses(xju::getHostName())[0],
+    TCPService(TCPService::Backlog(16),true).port());
+  ConnectionPool<> p(1,1,std::chrono::seconds(10));
+  for(int i=0; i!=2; ++i){
+    try{
+      p.checkout(endpoint,xju::steadyNow()+std::chrono::seconds(5));
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const&){
+    }
+  }
+  xju::assert_equal(p.stats().connectFailures_,2U);
+  xju::assert_equal(p.stats().open_,0U);
+}
+
+}
+}
+
+using namespace xju::ip;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,221 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/ip/PrefixTable.hh>
+
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <xju/assert.hh>
+
+namespace xju
+{
+namespace ip
+{
+
+typedef PrefixTable<v4::Address,std::string> Table4;
+
+std::string str(std::string const* x)
+{
+  return x?*x:"none";
+}
+
+std::string lookup(Table4 const& t, std::string const& a)
+{
+  return str(t.lookup(v4::Address(a)));
+}
+
+// v4 prefixes
+void test1() {
+  xju::assert_equal(v4::Prefix("10.1.2.3/16"),
+                    v4::Prefix(v4::Address("10.1.0.0"),16));
+  xju::assert_equal(v4::Prefix("0.0.0.0/0").contains(v4::Address("1.2.3.4")),
+                    true);
+  xju::assert_equal(v4::Prefix("10.1.2.3/32").contains(
+                      v4::Address("10.1.2.3")),true);
+  xju::assert_equal(v4::Prefix("10.1.2.3/32").contains(
+                      v4::Address("10.1.2.4")),false);
+  xju::assert_equal(v4::Prefix("10.128.0.0/9").contains(
+                      v4::Address("10.200.0.1")),true);
+  xju::assert_equal(v4::Prefix("10.128.0.0/9").contains(
+                      v4::Address("10.127.0.1")),false);
+  {
+    std::ostringstream s;
+    s << v4::Prefix("192.168.7.1/22");
+    xju::assert_equal(s.str(),"192.168.4.0/22");
+  }
+  try{
+    v4::Prefix("10.0.0.0/33");
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to parse \"10.0.0.0/33\" assuming it is an IPv4 prefix like 192.168.0.0/16 because\nprefix length 33 is more than 32.");
+  }
+  try{
+    v4::Prefix("10.0.0.0");
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to parse \"10.0.0.0\" assuming it is an IPv4 prefix like 192.168.0.0/16 because\nno /.");
+  }
+}
+
+// v4 table
+void test2() {
+  {
+    Table4 const t({});
+    xju::assert_equal(t.size(),0U);
+    xju::assert_equal(lookup(t,"10.1.2.3"),"none");
+  }
+  Table4 const t({
+      {v4::Prefix("10.0.0.0/8"),"a"},
+      {v4::Prefix("10.1.0.0/16"),"b"},
+      {v4::Prefix("10.1.2.0/24"),"c"},
+      {v4::Prefix("10.1.2.128/25"),"d"},
+      {v4::Prefix("10.1.2.3/32"),"e"},
+      {v4::Prefix("192.168.0.0/22"),"f"},
+      {v4::Prefix("10.1.0.0/16"),"g"},  // replaces b
+      {v4::Prefix("172.16.0.0/12"),"h"},
+      {v4::Prefix("10.2.3.4/31"),"i"}});
+  xju::assert_equal(t.size(),8U);
+  xju::assert_equal(lookup(t,"9.255.255.255"),"none");
+  xju::assert_equal(lookup(t,"10.0.0.0"),"a");
+  xju::assert_equal(lookup(t,"10.255.255.255"),"a");
+  xju::assert_equal(lookup(t,"10.1.0.0"),"g");
+  xju::assert_equal(lookup(t,"10.1.1.255"),"g");
+  xju::assert_equal(lookup(t,"10.1.2.0"),"c");
+  xju::assert_equal(lookup(t,"10.1.2.2"),"c");
+  xju::assert_equal(lookup(t,"10.1.2.3"),"e");
+  xju::assert_equal(lookup(t,"10.1.2.4"),"c");
+  xju::assert_equal(lookup(t,"10.1.2.127"),"c");
+  xju::assert_equal(lookup(t,"10.1.2.128"),"d");
+  xju::assert_equal(lookup(t,"10.1.2.255"),"d");
+  xju::assert_equal(lookup(t,"10.1.3.0"),"g");
+  xju::assert_equal(lookup(t,"10.2.3.3"),"a");
+  xju::assert_equal(lookup(t,"10.2.3.4"),"i");
+  xju::assert_equal(lookup(t,"10.2.3.5"),"i");
+  xju::assert_equal(lookup(t,"10.2.3.6"),"a");
+  xju::assert_equal(lookup(t,"172.15.255.255"),"none");
+  xju::assert_equal(lookup(t,"172.16.0.0"),"h");
+  xju::assert_equal(lookup(t,"172.31.255.255"),"h");
+  xju::assert_equal(lookup(t,"172.32.0.0"),"none");
+  xju::assert_equal(lookup(t,"192.168.3.255"),"f");
+  xju::assert_equal(lookup(t,"192.168.4.0"),"none");
+
+  Table4 const d({{v4::Prefix("0.0.0.0/0"),"default"},
+                  {v4::Prefix("10.1.2.3/32"),"x"}});
+  xju::assert_equal(lookup(d,"10.1.2.3"),"x");
+  xju::assert_equal(lookup(d,"10.1.2.2"),"default");
+  xju::assert_equal(lookup(d,"255.255.255.255"),"default");
+}
+
+// random v4 and v6 tables, against linear search, single and batch
+template<class Address, class Prefix>
+void check(std::vector<std::pair<Prefix,int> > const& prefixes,
+           std::vector<Address> const& addresses)
+{
+  PrefixTable<Address,int> const t(prefixes);
+  std::vector<int const*> batch(addresses.size());
+  t.lookup(addresses.data(),addresses.size(),batch.data());
+  for(size_t i=0; i!=addresses.size(); ++i){
+    auto const& a(addresses[i]);
+    // longest, latest
+    int expected(-1);
+    int longest(-1);
+    for(auto const& p: prefixes){
+      if (p.first.contains(a) && (int)p.first.length()>=longest){
+        longest=p.first.length();
+        expected=p.second;
+      }
+    }
+    int const* const x(t.lookup(a));
+    xju::assert_equal(x?*x:-1,expected);
+    xju::assert_equal(batch[i],x);
+  }
+}
+
+void test3() {
+  std::mt19937 r(1);
+  for(unsigned int n: {1U,10U,1000U}){
+    std::vector<std::pair<v4::Prefix,int> > prefixes;
+    std::vector<v4::Address> addresses;
+    for(unsigned int i=0; i!=n; ++i){
+      // clustered, so prefixes nest
+      v4::Address const a(0x0a000000|(r()&0x00ff0fff));
+      prefixes.push_back({v4::Prefix(a,r()%33),(int)i});
+      addresses.push_back(a);
+      addresses.push_back(v4::Address(a.value()^(1U<<(r()%32))));
+      addresses.push_back(v4::Address(r()));
+    }
+    check(prefixes,addresses);
+  }
+}
+
+v6::Address v6Address(uint64_t const hi, uint64_t const lo)
+{
+  v6::Address result;
+  for(size_t i=0; i!=8; ++i){
+    result[i]=hi>>(56-8*i);
+    result[8+i]=lo>>(56-8*i);
+  }
+  return result;
+}
+
+void test4() {
+  xju::assert_equal(v6::Prefix(v6Address(0x20010db8ffffffffULL,1),32),
+                    v6::Prefix(v6Address(0x20010db800000000ULL,0),32));
+  xju::assert_equal(v6::Prefix(v6Address(0x20010db8ffffffffULL,1),35),
+                    v6::Prefix(v6Address(0x20010db8e0000000ULL,0),35));
+  xju::assert_equal(v6::Prefix(v6Address(0x20010db8ffffffffULL,1),128)
+                    .address(),
+                    v6Address(0x20010db8ffffffffULL,1));
+  try{
+    v6::Prefix(v6Address(0,0),129);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"prefix length 129 is more than 128.");
+  }
+  std::mt19937_64 r(1);
+  for(unsigned int n: {1U,10U,1000U}){
+    std::vector<std::pair<v6::Prefix,int> > prefixes;
+    std::vector<v6::Address> addresses;
+    for(unsigned int i=0; i!=n; ++i){
+      // clustered, so prefixes nest
+      uint64_t const hi(0x20010db800000000ULL|(r()&0x00000000ff00ffffULL));
+      uint64_t const lo(r()&0xff000000000000ffULL);
+      v6::Address const a(v6Address(hi,lo));
+      prefixes.push_back({v6::Prefix(a,r()%129),(int)i});
+      addresses.push_back(a);
+      unsigned int const b(r()%128);
+      addresses.push_back(v6Address(hi^(b<64?1ULL<<(63-b):0),
+                                    lo^(b<64?0:1ULL<<(127-b))));
+      addresses.push_back(v6Address(r(),r()));
+    }
+    check(prefixes,addresses);
+  }
+}
+
+}
+}
+
+using namespace xju::ip;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
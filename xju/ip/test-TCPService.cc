@@ -17,6 +17,14 @@
 #include <xju/ip/TCPSocket.hh>
 #include <xju/ip/v4/getHostAddresses.hh>
 #include <xju/getHostName.hh>
+#include <xju/io/select.hh>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <xju/SyscallFailed.hh>
+#include <xju/syscall.hh>
+#include <sys/resource.h>
+#include <unistd.h>
 
 namespace xju
 {
@@ -56,6 +64,115 @@ void test2() {
   }
 }
 
+// connection storm spread across reuse-port listeners, one per thread,
+// each draining its pending connections per wakeup
+void test3() {
+  size_t const N(200);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(10));
+  std::vector<std::unique_ptr<TCPService>> listeners;
+  listeners.push_back(std::unique_ptr<TCPService>(
+    new TCPService(TCPService::Backlog(N),false,true,true)));
+  for(int i=0; i!=3; ++i){
+    listeners.push_back(std::unique_ptr<TCPService>(
+      new TCPService(listeners[0]->port(),
+                     TCPService::Backlog(N),false,true,true)));
+  }
+  for(auto& l: listeners){
+    l->deferAccept(std::chrono::seconds(5));
+    l->enableFastOpen(16);
+    xju::assert_equal(l->acceptPending(10).size(),0U);
+  }
+  std::atomic<size_t> total(0);
+  std::vector<size_t> accepted(listeners.size(),0);
+  std::vector<std::unique_ptr<xju::Thread>> workers;
+  for(size_t i=0; i!=listeners.size(); ++i){
+    workers.push_back(std::unique_ptr<xju::Thread>(new xju::Thread([&,i](){
+        std::vector<std::unique_ptr<TCPSocket>> connections;
+        while(total<N && xju::steadyNow()<deadline){
+          xju::io::select({listeners[i].get()},
+                          xju::steadyNow()+std::chrono::milliseconds(10));
+          for(auto& c: listeners[i]->acceptPending(8)){
+            // deferred accept means data is already there
+            char x;
+            xju::assert_equal(c->read(&x,1,xju::steadyNow()),1U);
+            xju::assert_equal(x,'x');
+            connections.push_back(std::move(c));
+            ++accepted[i];
+            ++total;
+          }
+        }
+      })));
+  }
+  std::vector<std::unique_ptr<TCPSocket>> clients;
+  for(size_t i=0; i!=N; ++i){
+    clients.push_back(std::unique_ptr<TCPSocket>(new TCPSocket(
+      {xju::ip::v4::getHostAddresses(xju::getHostName())[0],
+       listeners[0]->port()},
+      deadline)));
+    clients.back()->write("x",1,deadline);
+  }
+  workers.clear();
+  xju::assert_equal(total.load(),N);
+  size_t used(0);
+  for(auto n: accepted){
+    used+=(n!=0);
+  }
+  xju::assert_greater(used,1U);
+}
+
+// tryAccept: none pending, then one
+void test4() {
+  TCPService s(TCPService::Backlog(1),true);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  xju::assert_equal(s.tryAccept().get(),(TCPSocket*)0);
+  TCPSocket c(
+    {xju::ip::v4::getHostAddresses(xju::getHostName())[0],s.port()},
+    deadline);
+  xju::io::select({&s},deadline);
+  auto const x(s.tryAccept());
+  xju::assert_not_equal(x.get(),(TCPSocket*)0);
+  xju::assert_equal(x->peerAddress(),c.localAddress());
+  xju::assert_equal(s.tryAccept().get(),(TCPSocket*)0);
+}
+
+// acceptPending out of file descriptors part way: returns what it
+// accepted, throws only if it accepted none
+void test5() {
+  TCPService s(TCPService::Backlog(4),true);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  std::vector<std::unique_ptr<TCPSocket>> clients;
+  for(size_t i=0; i!=3; ++i){
+    clients.push_back(std::unique_ptr<TCPSocket>(new TCPSocket(
+      {xju::ip::v4::getHostAddresses(xju::getHostName())[0],s.port()},
+      deadline)));
+  }
+  rlimit original;
+  xju::syscall("getrlimit",::getrlimit,XJU_TRACED)(RLIMIT_NOFILE,&original);
+  {
+    // room for exactly one more file descriptor
+    int const fd(::dup(0));
+    ::close(fd);
+    rlimit r(original);
+    r.rlim_cur=fd+1;
+    xju::syscall("setrlimit",::setrlimit,XJU_TRACED)(RLIMIT_NOFILE,&r);
+  }
+  auto const x(s.acceptPending(10));
+  xju::assert_equal(x.size(),1U);
+  try{
+    s.acceptPending(10,false);
+    xju::assert_never_reached();
+  }
+  catch(xju::SyscallFailed const& e){
+    xju::assert_equal(e._errno,EMFILE);
+    xju::assert_not_equal(
+      readableRepr(e).find("pending connections on "+s.str()+
+                           ", not closing connection sockets on exec"),
+      std::string::npos);
+  }
+  xju::syscall("setrlimit",::setrlimit,XJU_TRACED)(RLIMIT_NOFILE,&original);
+  xju::assert_equal(s.acceptPending(10).size(),2U);
+}
+
 }
 }
 
@@ -66,6 +183,9 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  test5(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
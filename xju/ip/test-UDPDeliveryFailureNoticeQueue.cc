@@ -10,11 +10,13 @@
 #include <xju/ip/UDPDeliveryFailureNoticeQueue.hh>
 
 #include <iostream>
+#include <string>
 #include <xju/assert.hh>
 #include <xju/HostName.hh>
 #include <xju/ip/UDPSocket.hh>
 #include <xju/steadyNow.hh>
 #include <xju/io/poll.hh>
+#include <xju/ip/timestamping.hh>
 
 namespace xju
 {
@@ -105,6 +107,134 @@ void test2(xju::ip::v4::Address const& arpFailureHost)
   
 }
 
+void test3()
+{
+  // kernel timestamps of datagrams sent and received
+  UDPSocket s1;
+  UDPSocket s2;
+  UDPDeliveryFailureNoticeQueue q2(s2);
+  s1.enableTimestamping();
+  s2.enableTimestamping();
+
+  // warm up: the kernel enables receive timestamps lazily, so the
+  // first datagram(s) after enabling can arrive without one
+  uint32_t warmUp(0);
+  for(bool stamped(false); !stamped; ++warmUp){
+    xju::assert_less(warmUp,10U);
+    s2.sendTo({xju::ip::v4::Address("127.0.0.1"),s1.port()},
+              "fred",5U,xju::steadyNow());
+    char buffer[5];
+    xju::ip::timestamping::Timestamps arrived;
+    s1.receive(buffer,sizeof(buffer),
+               xju::steadyNow()+std::chrono::seconds(1),arrived);
+    stamped=arrived.software_.valid();
+  }
+
+  std::vector<xju::ip::timestamping::Timestamps> received;
+  for(int i=0; i!=3; ++i){
+    s2.sendTo({xju::ip::v4::Address("127.0.0.1"),s1.port()},
+              "fred",5U,xju::steadyNow());
+    char buffer[5];
+    xju::ip::timestamping::Timestamps arrived;
+    s1.receive(buffer,sizeof(buffer),
+               xju::steadyNow()+std::chrono::seconds(1),arrived);
+    xju::assert_equal(arrived.software_.valid(),true);
+    received.push_back(arrived);
+  }
+  // transmit timestamps arrive via s2's error queue, which polls as
+  // error
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(1));
+  std::vector<xju::ip::timestamping::SendTimestamp> sent;
+  while(sent.size()<3){
+    xju::io::poll({&s2},{},deadline);
+    for(auto const& x: q2.getSendTimestamps()){
+      // ignore warm up sends
+      if (x.id_>=warmUp){
+        sent.push_back(x);
+      }
+    }
+    xju::assert_less(xju::steadyNow(),deadline);
+  }
+  xju::assert_equal(sent.size(),3U);
+  for(uint32_t i=0; i!=3; ++i){
+    xju::assert_equal(sent[i].id_,warmUp+i);
+    auto const l(xju::ip::timestamping::latency(sent[i].at_,received[i]));
+    xju::assert_equal(l.valid(),true);
+    xju::assert_greater_equal(l.value(),std::chrono::nanoseconds(0));
+    xju::assert_less(l.value(),std::chrono::seconds(1));
+  }
+  xju::assert_equal(
+    q2.getFailureNotices(),
+    std::vector<UDPDeliveryFailureNoticeQueue::DeliveryFailureNotice>());
+
+  // not enabled
+  UDPSocket s3;
+  s2.sendTo({xju::ip::v4::Address("127.0.0.1"),s3.port()},
+            "fred",5U,xju::steadyNow());
+  {
+    char buffer[5];
+    xju::ip::timestamping::Timestamps arrived;
+    s3.receive(buffer,sizeof(buffer),
+               xju::steadyNow()+std::chrono::seconds(1),arrived);
+    xju::assert_equal(arrived.software_.valid(),false);
+    xju::assert_equal(arrived.hardware_.valid(),false);
+  }
+}
+
+void test4()
+{
+  // request/response on one timestamping socket: queued transmit
+  // timestamps make the socket select readable, receive must still
+  // wait for a datagram (until its deadline)
+  UDPSocket s1;
+  UDPSocket s2;
+  UDPDeliveryFailureNoticeQueue q1(s1);
+  s1.enableTimestamping();
+
+  s1.sendTo({xju::ip::v4::Address("127.0.0.1"),s2.port()},
+            "req",4U,xju::steadyNow());
+  char buffer[4];
+  s2.receive(buffer,sizeof(buffer),xju::steadyNow()+std::chrono::seconds(1));
+
+  auto const t1(xju::steadyNow());
+  try{
+    s1.receive(buffer,sizeof(buffer),t1+std::chrono::milliseconds(200));
+    xju::assert_never_reached();
+  }
+  catch(xju::DeadlineReached const&){
+    xju::assert_greater_equal(xju::steadyNow(),
+                              t1+std::chrono::milliseconds(200));
+  }
+  UDPSocket::Batch b(4,8);
+  auto const t2(xju::steadyNow());
+  try{
+    s1.receiveMany(b,t2+std::chrono::milliseconds(100));
+    xju::assert_never_reached();
+  }
+  catch(xju::DeadlineReached const&){
+    xju::assert_greater_equal(xju::steadyNow(),
+                              t2+std::chrono::milliseconds(100));
+  }
+  s2.sendTo({xju::ip::v4::Address("127.0.0.1"),s1.port()},
+            "rsp",4U,xju::steadyNow());
+  xju::ip::timestamping::Timestamps arrived;
+  s1.receive(buffer,sizeof(buffer),
+             xju::steadyNow()+std::chrono::seconds(1),arrived);
+  xju::assert_equal(std::string(buffer),std::string("rsp"));
+  xju::assert_equal(arrived.software_.valid(),true);
+
+  // the transmit timestamp read by receive is still collected
+  auto const sent(q1.getSendTimestamps());
+  xju::assert_equal(sent.size(),1U);
+  xju::assert_equal(sent[0].id_,0U);
+  auto const l(xju::ip::timestamping::latency(sent[0].at_,arrived));
+  xju::assert_equal(l.valid(),true);
+  xju::assert_greater_equal(l.value(),std::chrono::milliseconds(300));
+  xju::assert_equal(
+    q1.getFailureNotices(),
+    std::vector<UDPDeliveryFailureNoticeQueue::DeliveryFailureNotice>());
+}
+
 }
 }
 
@@ -114,6 +244,8 @@ int main(int argc, char* argv[])
 {
   unsigned int n(0);
   test1(), ++n;
+  test3(), ++n;
+  test4(), ++n;
   if(argc==2 && std::string(argv[1])!=""){
     test2(xju::ip::v4::Address(argv[1])), ++n;
   }
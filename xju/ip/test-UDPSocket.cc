@@ -20,6 +20,7 @@
 #include <xju/format.hh>
 #include <xju/socket.hh>
 #include <xju/steadyNow.hh>
+#include <xju/io/select.hh>
 
 namespace xju
 {
@@ -138,6 +139,140 @@ void test2()
   }
 }
 
+// gather send
+void test3()
+{
+  UDPSocket s1;
+  UDPSocket s2;
+  xju::ip::v4::Address localhost(
+    xju::ip::v4::getHostAddresses(xju::HostName("localhost"))[0]);
+  std::string const a("fred ");
+  std::string const b("jock");
+  std::vector<iovec> const v({
+      {(void*)a.data(),a.size()},
+      {(void*)b.data(),b.size()}});
+  s1.sendTo({localhost,s2.port()},v.data(),v.size(),xju::steadyNow());
+  std::vector<char> r(100,0);
+  auto const rr(
+    s2.receive(r.data(),r.size(),
+               std::chrono::steady_clock::now()+std::chrono::seconds(1)));
+  xju::assert_equal(rr.first.second,s1.port());
+  xju::assert_equal(std::string(r.begin(),r.begin()+rr.second),
+                    std::string("fred jock"));
+}
+
+// batch send and receive
+void test4()
+{
+  UDPSocket s1;
+  UDPSocket s2;
+  xju::ip::v4::Address localhost(
+    xju::ip::v4::getHostAddresses(xju::HostName("localhost"))[0]);
+  UDPSocket::Batch b1(10,16);
+  for(size_t i=0; i!=10; ++i){
+    std::string const x(i+1,'a'+i);
+    b1.push_back({localhost,s2.port()},x.data(),x.size());
+  }
+  xju::assert_equal(b1.size(),10U);
+  s1.sendMany(b1,xju::steadyNow()+std::chrono::seconds(1));
+
+  UDPSocket::Batch b2(16,8);
+  size_t n(0);
+  while(n!=10){
+    auto const deadline(xju::steadyNow()+std::chrono::seconds(1));
+    auto const m(s2.receiveMany(b2,deadline));
+    xju::assert_equal(m,b2.size());
+    for(size_t i=0; i!=b2.size(); ++i,++n){
+      xju::assert_equal(b2.peer(i),std::make_pair(localhost,s1.port()));
+      xju::assert_equal(b2.truncated(i),n+1>8);
+      xju::assert_equal(b2.length(i),std::min(n+1,(size_t)8));
+      xju::assert_equal(std::string((char const*)b2.data(i),b2.length(i)),
+                        std::string(b2.length(i),'a'+n));
+      xju::assert_equal(b2.drops(i),0U);
+    }
+  }
+  try{
+    s2.receiveMany(b2,xju::steadyNow());
+    xju::assert_never_reached();
+  }
+  catch(xju::DeadlineReached const& e){
+    xju::assert_startswith(readableRepr(e),"Failed to receive up to 16 udp datagrams (each up to 8 bytes) on port "+xju::format::str(s2.port())+" within ");
+    xju::assert_endswith(readableRepr(e),std::string(" because\ndeadline reached before socket readable."));
+  }
+  xju::assert_equal(b2.size(),0U);
+}
+
+// segmentation offload, over loopback
+void test5()
+{
+  UDPSocket s1;
+  UDPSocket s2;
+  xju::ip::v4::Address localhost(
+    xju::ip::v4::getHostAddresses(xju::HostName("localhost"))[0]);
+  // without and with receive offload (note kernel might not support it)
+  for(int pass=0; pass!=2; ++pass){
+    bool const gro(pass==1 && s2.enableGRO());
+    // 200 datagrams, so more than one offloaded send
+    std::vector<uint8_t> x(200*100-1);
+    for(size_t i=0; i!=x.size(); ++i){
+      x[i]=i/100;
+    }
+    xju::assert_equal(
+      s1.sendSegments({localhost,s2.port()},x.data(),x.size(),100,
+                      xju::steadyNow()+std::chrono::seconds(1)),
+      200U);
+    std::vector<uint8_t> buffer(UDPSocket::MAX_DATAGRAM_SIZE);
+    size_t n(0);
+    size_t coalesced(0);
+    while(n!=200){
+      auto const r(
+        s2.receiveSegments(buffer.data(),buffer.size(),
+                           xju::steadyNow()+std::chrono::seconds(1)));
+      xju::assert_equal(r.sender(),std::make_pair(localhost,s1.port()));
+      coalesced+=(r.size()>1);
+      for(size_t i=0; i!=r.size(); ++i,++n){
+        auto const d(r[i]);
+        xju::assert_equal(d.second,n==199?99U:100U);
+        xju::assert_equal(std::vector<uint8_t>(d.first,d.first+d.second),
+                          std::vector<uint8_t>(d.second,n));
+      }
+    }
+    if (!gro){
+      xju::assert_equal(coalesced,0U);
+    }
+  }
+}
+
+// try-variants: nothing queued, then a datagram
+void test6()
+{
+  UDPSocket s1;
+  UDPSocket s2;
+  xju::ip::v4::Address localhost(
+    xju::ip::v4::getHostAddresses(xju::HostName("localhost"))[0]);
+  std::vector<char> r(100,0);
+  xju::assert_equal(s2.tryReceive(r.data(),r.size()).valid(),false);
+  UDPSocket::Batch b(4,100);
+  xju::assert_equal(s2.tryReceiveMany(b),0U);
+  xju::assert_equal(b.size(),0U);
+
+  std::string const fred("fred");
+  xju::assert_equal(
+    s1.trySendTo({localhost,s2.port()},fred.c_str(),fred.size()),true);
+  xju::assert_equal(
+    s1.trySendTo({localhost,s2.port()},fred.c_str(),fred.size()),true);
+  xju::io::select({(xju::io::Input const*)&s2},
+                  xju::steadyNow()+std::chrono::seconds(1));
+  auto const rr(s2.tryReceive(r.data(),r.size()));
+  xju::assert_equal(rr.valid(),true);
+  xju::assert_equal(rr.value().first.second,s1.port());
+  xju::assert_equal(std::string(r.begin(),r.begin()+rr.value().second),fred);
+  xju::io::select({(xju::io::Input const*)&s2},
+                  xju::steadyNow()+std::chrono::seconds(1));
+  xju::assert_equal(s2.tryReceiveMany(b),1U);
+  xju::assert_equal(s2.tryReceiveMany(b),0U);
+}
+
 }
 }
 
@@ -149,6 +284,10 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  test5(), ++n;
+  test6(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
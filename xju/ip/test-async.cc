@@ -0,0 +1,145 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/ip/async.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/format.hh>
+#include <xju/steadyNow.hh>
+#include <xju/steadyEternity.hh>
+#include <xju/ip/v4/getHostAddresses.hh>
+#include <xju/getHostName.hh>
+#include <memory>
+#include <string>
+
+namespace xju
+{
+namespace ip
+{
+namespace async
+{
+
+// TCP echo server and clients all as coroutines of one scheduler
+void test1() {
+  xju::io::Scheduler s;
+  TCPService service(TCPService::Backlog(64),true);
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  size_t const N(50);
+  s.spawn([&](){
+      for(size_t i=0; i!=N; ++i){
+        std::shared_ptr<TCPSocket> c(accept(s,service,deadline));
+        s.spawn([&s,c,deadline](){
+            char x[4];
+            s.readAll(*c,x,sizeof(x),deadline);
+            s.yield();
+            s.writeAll(*c,x,sizeof(x),deadline);
+          });
+      }
+    });
+  size_t echoed(0);
+  for(size_t i=0; i!=N; ++i){
+    s.spawn([&,i](){
+        TCPSocket c(
+          {xju::ip::v4::getHostAddresses(xju::getHostName())[0],
+           service.port()},
+          deadline);
+        std::string const x(xju::format::int_(1000+i));
+        s.writeAll(c,x.data(),x.size(),deadline);
+        char y[4];
+        s.readAll(c,y,sizeof(y),deadline);
+        xju::assert_equal(std::string(y,sizeof(y)),x);
+        ++echoed;
+      });
+  }
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+  xju::assert_equal(echoed,N);
+
+  // no connection by deadline
+  s.spawn([&](){
+      try{
+        accept(s,service,xju::steadyNow()+std::chrono::milliseconds(10));
+        xju::assert_never_reached();
+      }
+      catch(xju::DeadlineReached const& e){
+        xju::assert_equal(readableRepr(e),"Failed to accept connection on "+service.str()+" by deadline because\ndeadline reached before connection arrived.");
+      }
+    });
+  s.run(xju::steadyEternity());
+}
+
+// UDP request/response
+void test2() {
+  xju::io::Scheduler s;
+  UDPSocket a;
+  UDPSocket b;
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  auto const local(xju::ip::v4::getHostAddresses(xju::getHostName())[0]);
+  std::string reply;
+  s.spawn([&](){
+      char x[16];
+      auto const r(receive(s,b,x,sizeof(x),deadline));
+      xju::assert_equal(r.first.second,a.port());
+      std::string const y(std::string(x,r.second)+"!");
+      sendTo(s,b,r.first,y.data(),y.size(),deadline);
+    });
+  s.spawn([&](){
+      // let b's coroutine wait first
+      s.yield();
+      sendTo(s,a,{local,b.port()},"fred",4,deadline);
+      char x[16];
+      auto const r(receive(s,a,x,sizeof(x),deadline));
+      reply=std::string(x,r.second);
+    });
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+  xju::assert_equal(reply,"fred!");
+
+  // batch
+  size_t received(0);
+  s.spawn([&](){
+      UDPSocket::Batch x(8,16);
+      while(received!=3){
+        received+=receiveMany(s,a,x,deadline);
+      }
+    });
+  s.spawn([&](){
+      s.yield();
+      for(int i=0; i!=3; ++i){
+        sendTo(s,b,{local,a.port()},"jock",4,deadline);
+      }
+    });
+  xju::assert_equal(s.run(xju::steadyEternity()),0U);
+
+  s.spawn([&](){
+      char x[16];
+      try{
+        receive(s,a,x,sizeof(x),xju::steadyNow()+std::chrono::milliseconds(10));
+        xju::assert_never_reached();
+      }
+      catch(xju::DeadlineReached const& e){
+        xju::assert_equal(readableRepr(e),"Failed to receive udp datagram (up to 16 bytes) on "+a.str()+" by deadline because\ndeadline reached before socket readable.");
+      }
+    });
+  s.run(xju::steadyEternity());
+}
+
+}
+}
+}
+
+using namespace xju::ip::async;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
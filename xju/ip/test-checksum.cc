@@ -9,9 +9,13 @@
 //
 #include <xju/ip/checksum/validate.hh>
 #include <xju/ip/checksum/calculate.hh>
+#include <xju/ip/checksum/update.hh>
+#include <xju/ip/checksum/sum.hh>
 
 #include <iostream>
 #include <xju/assert.hh>
+#include <list>
+#include <random>
 
 namespace xju
 {
@@ -52,6 +56,101 @@ void test3() {
   }
 }
 
+// byte at a time, for comparison
+uint16_t slowSum(uint8_t const* x, size_t size, uint16_t initial)
+{
+  uint32_t s(initial);
+  for(size_t i=0; i<size; i+=2){
+    s+=(uint16_t)(x[i]<<8)+(i+1==size?0:x[i+1]);
+    s=(s&0xffff)+(s>>16);
+  }
+  return s;
+}
+
+// word and vector sums at all alignments, sizes, including enough to
+// overflow 32-bit lanes
+void test4() {
+  std::mt19937 r(1);
+  std::vector<uint8_t> x(1024+8);
+  for(auto& c: x){
+    c=r();
+  }
+  for(size_t a=0; a!=8; ++a){
+    for(size_t n=0; n+a<=x.size(); ++n){
+      uint16_t const initial(n*31);
+      xju::assert_equal(sum(x.data()+a,n,initial),
+                        slowSum(x.data()+a,n,initial));
+    }
+  }
+  std::vector<uint8_t> y(3*1024*1024+5,0xff);
+  y[7]=0xfe;
+  xju::assert_equal(sum(y.data()+1,y.size()-1),
+                    slowSum(y.data()+1,y.size()-1,0));
+
+  // span by span
+  xju::assert_equal(sum(x.data()+100,x.size()-100,sum(x.data(),100)),
+                    sum(x.data(),x.size()));
+
+  // non-contiguous iterators
+  std::list<uint8_t> const z(x.begin(),x.begin()+999);
+  xju::assert_equal(sum(z.begin(),z.end(),7),sum(x.data(),999,7));
+
+  xju::assert_equal(calculate(x.data(),999),
+                    calculate(xju::ip::decode::makeIterator(
+                                x.begin(),x.begin()+999)));
+  xju::assert_equal(calculate(x.data(),999),
+                    calculate(xju::ip::decode::makeIterator(
+                                z.begin(),z.end())));
+}
+
+// incremental update
+void test5() {
+  std::vector<uint8_t> x{
+    0x45, 0x00,
+    0x00, 0x54, 0xbb, 0xdb, 0x40, 0x00, 0x40, 0x01,
+    0x00, 0x00, 0xc0, 0xa8, 0x00, 0x03, 0xc0, 0xa8,
+    0x00, 0x01};
+  Checksum const c(calculate(x.data(),x.size()));
+
+  // decrement ttl
+  x[8]=0x3f;
+  xju::assert_equal(update(c,(uint16_t)0x4001,(uint16_t)0x3f01),
+                    calculate(x.data(),x.size()));
+  x[8]=0x40;
+
+  // rewrite destination address
+  x[16]=0x0a; x[17]=0x01; x[18]=0x02; x[19]=0x03;
+  xju::assert_equal(update(c,(uint32_t)0xc0a80001,(uint32_t)0x0a010203),
+                    calculate(x.data(),x.size()));
+  uint8_t const from[]={0xc0,0xa8,0x00,0x01};
+  xju::assert_equal(update(c,from,x.data()+16,4),
+                    calculate(x.data(),x.size()));
+
+  // random rewrites of random data, checksum at offset 40
+  std::mt19937 r(1);
+  std::vector<uint8_t> y(64);
+  for(auto& c: y){
+    c=r();
+  }
+  y[40]=0;
+  y[41]=0;
+  Checksum z(calculate(y.data(),y.size()));
+  for(int i=0; i!=10000; ++i){
+    size_t const j((40+2+r()%31*2)%64);
+    uint16_t const from((y[j]<<8)+y[j+1]);
+    uint16_t const to(i%100==0?0:r());
+    y[j]=to>>8;
+    y[j+1]=to;
+    z=update(z,from,to);
+    y[40]=z.value()>>8;
+    y[41]=z.value();
+    validate(y.data(),y.size());
+    y[40]=0;
+    y[41]=0;
+    xju::assert_equal(z,calculate(y.data(),y.size()));
+  }
+}
+
 }
 }
 }
@@ -64,6 +163,8 @@ int main(int argc, char* argv[])
   test1(), ++n;
   test2(), ++n;
   test3(), ++n;
+  test4(), ++n;
+  test5(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
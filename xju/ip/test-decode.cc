@@ -11,6 +11,47 @@
 
 #include <iostream>
 #include <xju/assert.hh>
+#include <list>
+#include <new>
+#include <cstdlib>
+
+namespace
+{
+size_t allocations(0);
+}
+
+// count allocations by replacing the global allocation functions;
+// all scalar and array, sized and unsized forms are replaced so that
+// every new is paired with a matching delete; they are kept out of
+// line so the compiler does not pair an inlined malloc/free with new
+__attribute__((noinline)) void* operator new(size_t n)
+{
+  ++allocations;
+  if (void* result=std::malloc(n?n:1)){
+    return result;
+  }
+  throw std::bad_alloc();
+}
+void* operator new[](size_t n)
+{
+  return ::operator new(n);
+}
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+void operator delete[](void* p) noexcept
+{
+  ::operator delete(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+  ::operator delete(p);
+}
+void operator delete[](void* p, size_t) noexcept
+{
+  ::operator delete(p);
+}
 
 namespace xju
 {
@@ -41,6 +82,67 @@ void test1() {
   }
 }
 
+// multi-byte and bulk reads, including running out part way
+void test2() {
+  std::vector<uint8_t> const x{1,2,3,4,5,6,7};
+  {
+    auto i{makeIterator(x.begin(),x.end())};
+    i.get8Bits("a");
+    try{
+      i.get32Bits("b");
+      i.get32Bits("c");
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"Failed to read 32 bit \"c\" having read 7 bytes and 0 bits because\nfailed to read 16 bits having read 7 bytes and 0 bits because\nfailed to read 8 bits having read 7 bytes and 0 bits because\nend of input.");
+    }
+  }
+  {
+    auto i{makeIterator(x.begin(),x.end()-2)};
+    i.get32Bits("a");
+    try{
+      i.get16Bits("");
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"Failed to read 16 bits having read 5 bytes and 0 bits because\nfailed to read 8 bits having read 5 bytes and 0 bits because\nend of input.");
+    }
+  }
+  {
+    std::list<uint8_t> const y(x.begin(),x.end());
+    auto i{makeIterator(y.begin(),y.end())};
+    xju::assert_equal(i.get16Bits(""),0x0102);
+    uint8_t z[4];
+    xju::assert_equal(i.getBytes(4,z,"z"),z+4);
+    xju::assert_equal(std::vector<uint8_t>(z,z+4),
+                      std::vector<uint8_t>(x.begin()+2,x.begin()+6));
+    xju::assert_equal(i.currentOffset().bytes(),6U);
+    try{
+      i.getBytes(2,z,"z");
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"Failed to read 2 bytes \"z\" having read 7 bytes and 0 bits because\nend of input.");
+    }
+  }
+}
+
+// successful reads do not allocate
+void test3() {
+  std::vector<uint8_t> const x{0x45,0,0,0x54,0xbb,0xdb,0x40,0,0x40,1};
+  uint8_t y[2];
+  size_t const before(allocations);
+  auto i{makeIterator(x.begin(),x.end())};
+  xju::assert_equal(i.get4Bits("version"),4U);
+  xju::assert_equal(i.get4Bits("internal header length"),5U);
+  xju::assert_equal(i.get8Bits("DSCP, ECN"),0U);
+  xju::assert_equal(i.get16Bits("total length"),0x54U);
+  xju::assert_equal(i.get32Bits("identification, flags, fragment offset"),
+                    0xbbdb4000U);
+  i.getBytes(2,y,"ttl, protocol");
+  xju::assert_equal(allocations,before);
+}
+
 }
 }
 }
@@ -51,6 +153,8 @@ int main(int argc, char* argv[])
 {
   unsigned int n(0);
   test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
@@ -8,6 +8,7 @@
 // implied warranty.
 //
 #include <xju/linux/wtmp/LoginMonitor.hh>
+#include <xju/io/InotifyService.hh>
 #include <xju/steadyNow.hh>
 #include <sstream>
 #include <xju/format.hh>
@@ -30,7 +31,8 @@ int main(int argc, char* argv[])
   }
   try{
     auto const fileName{xju::path::split(argv[1])};
-    xju::linux::wtmp::LoginMonitor m{fileName,0};
+    xju::io::InotifyService inotify;
+    xju::linux::wtmp::LoginMonitor m{inotify,fileName,0};
 
     // skip existing
     auto const events{m.readEvents(xju::steadyNow())};
@@ -23,6 +23,8 @@
 #include <xju/next.hh>
 #include <thread>
 #include <xju/test/call.hh>
+#include <xju/io/InotifyService.hh>
+#include <xju/io/FileObserver.hh>
 
 namespace xju
 {
@@ -71,7 +73,8 @@ void test1() {
   auto const wtmp1{xju::path::split("wtmp.1")};
   rmf(wtmp);
   rmf(wtmp1);
-  LoginMonitor m{wtmp,2};
+  xju::io::InotifyService inotify;
+  LoginMonitor m{inotify,wtmp,2};
   xju::assert_equal(m.readEvents(xju::steadyNow()),
                     std::vector<UserLoggedIn>());
 
@@ -175,7 +178,8 @@ void test3(){
   auto const wtmp{xju::path::split("wtmp")};
   auto const wtmp1{xju::path::split("wtmp.1")};
   rmf(wtmp);
-  LoginMonitor m{wtmp,2};
+  xju::io::InotifyService inotify;
+  LoginMonitor m{inotify,wtmp,2};
   xju::io::FileWriter writer{wtmp,xju::file::Mode(0666)};
   std::this_thread::sleep_for(std::chrono::milliseconds(100));
   {
@@ -233,6 +237,33 @@ void test3(){
   }
 }
 
+void test4(){
+  // inotify service shared with another observer
+  auto const wtmp{xju::path::split("wtmp")};
+  auto const other{xju::path::split("other")};
+  rmf(wtmp);
+  xju::io::InotifyService inotify;
+  LoginMonitor m{inotify,wtmp,2};
+  xju::io::FileObserver o(inotify,{other});
+  xju::assert_equal(inotify.size(),1U);
+  xju::io::FileWriter writer{wtmp,xju::file::Mode(0666)};
+  xju::assert_equal(m.readEvents(xju::steadyNow()),
+                    std::vector<UserLoggedIn>());
+  {
+    auto const r{loggedIn("l1","fred",std::chrono::seconds(1))};
+    writer.write(&r,sizeof(r));
+  }
+  // other observer reads wtmp's events from the kernel but does not
+  // report them
+  xju::assert_equal(o.read(xju::steadyNow()).size(),0U);
+  auto const events{m.readEvents(xju::steadyNow()+std::chrono::seconds(1))};
+  xju::assert_equal(events.size(),1U);
+  xju::assert_equal(*events.begin(),
+                    UserLoggedIn("fred","hh",
+                                 xju::unix_epoch()+
+                                 std::chrono::seconds(1)));
+}
+
 }
 }
 }
@@ -245,6 +276,7 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test3(), ++n;
+  test4(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
@@ -65,6 +65,44 @@ void test2() {
     
 }
 
+// multi-byte values, bulk reads and token search spanning underflow()
+// boundaries, for all buffer sizes
+void test3() {
+  std::vector<uint8_t> x{
+    0x46,0x47,
+    0x51,0x52,0x53,0x54,
+    0x70,0x71,0x72,0x73,0x74,0x75,0x76,0x77};
+  std::string const t("xxaxbxxa\r\r\n\r\nz");
+  x.insert(x.end(),t.begin(),t.end());
+  for(size_t inc=1; inc!=x.size()+1; ++inc){
+    xju::MemIBuf b(x,inc);
+    istream s(b);
+    xju::assert_equal(s.get16(),0x4647);
+    xju::assert_equal(s.get32(),0x51525354);
+    xju::assert_equal(s.get64(),0x7071727374757677);
+    std::vector<uint8_t> y(3,0);
+    xju::assert_equal(s.getN(2,y.begin())==y.begin()+2,true);
+    xju::assert_equal(y,std::vector<uint8_t>({'x','x',0}));
+    xju::assert_equal(s.readThrough("xxa",100),std::string("axbxxa"));
+    xju::assert_equal(s.readThrough("\r\n",100),std::string("\r\r\n"));
+    try{
+      s.readThrough("q",2);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"Failed to read up to and including \"q\" expected within the next 0 characters having read \"\\r\\n\" because\n2 bytes read without seeing token.");
+    }
+    std::string z;
+    try{
+      s.getN(2,std::back_inserter(z));
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(z,"z");
+    }
+  }
+}
+
 }
 }
 
@@ -75,6 +113,7 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
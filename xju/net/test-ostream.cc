@@ -12,6 +12,7 @@
 #include <iostream>
 #include <xju/assert.hh>
 #include <xju/MemOBuf.hh>
+#include <list>
 
 namespace xju
 {
@@ -62,6 +63,33 @@ void test2() {
                     y);
 }
 
+// multi-byte values and bulk writes spanning flush() boundaries, for all
+// buffer sizes
+void test3() {
+  std::vector<uint8_t> const y{
+    0x23,0x24,
+    0x32,0x33,0x34,0x35,
+    0x60,0x61,0x62,0x63,0x64,0x65,0x66,0x67,
+    'f','r','e','d',
+    'j','o','c','k'};
+  for(size_t inc=1; inc!=y.size()+1; ++inc){
+    xju::MemOBuf buf(inc,y.size());
+    {
+      xju::net::ostream s(buf);
+      std::list<uint8_t> const jock{'j','o','c','k'};
+      s.put16(0x2324)
+        .put32(0x32333435)
+        .put64(0x6061626364656667)
+        .put(std::string("fred"))
+        .put(jock.begin(),jock.end());
+    }
+    xju::assert_equal(std::vector<uint8_t>(
+                        buf.data().first,
+                        buf.data().second),
+                      y);
+  }
+}
+
 }
 }
 
@@ -72,6 +100,7 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/MMapLogSink.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/unix_epoch.hh>
+#include <xju/file/rm.hh>
+
+namespace xju
+{
+namespace netflow
+{
+
+void rm(std::pair<xju::path::AbsolutePath,xju::path::FileName> const& f) {
+  try{
+    xju::file::rm(f);
+  }
+  catch(xju::Exception const&){
+  }
+}
+
+// append two reports, read back after reopen
+void test1() {
+  auto const f(xju::path::split("test-MMapLogSink.log"));
+  rm(f);
+  auto const t(xju::unix_epoch()+std::chrono::milliseconds(1700000000123));
+  {
+    MMapLog log(f);
+    MMapLogSink x(log);
+    Report r{t,t+std::chrono::seconds(1),{},{},2,3};
+    r.flows_.add(FlowKey{xju::ip::Protocol(17),
+                         xju::ip::v4::Address("10.0.0.1"),
+                         xju::ip::Port(53),
+                         xju::ip::v4::Address("10.0.0.2"),
+                         xju::ip::Port(40000)},
+                 1,80);
+    SequenceGaps g;
+    g.update(7,30);
+    r.exporters_.insert({Exporter{xju::ip::v4::Address("10.0.0.9"),
+                                  xju::ip::Port(2055),
+                                  0x102},
+                         g.stats()});
+    x.report(r);
+    x.report(Report{t+std::chrono::seconds(1),t+std::chrono::seconds(2),
+                    {},{},2,4});
+  }
+  MMapLog log(f);
+  xju::assert_equal(log.crashed(),false);
+  auto i(log.begin());
+  xju::assert_equal(MMapLogSink::type(log,i),MMapLogSink::FLOW);
+  {
+    auto const& y(log.get<MMapLogSink::Flow>(i));
+    xju::assert_equal(y.protocol_,17U);
+    xju::assert_equal(y.srcAddress_,0x0a000001U);
+    xju::assert_equal(y.srcPort_,53U);
+    xju::assert_equal(y.destAddress_,0x0a000002U);
+    xju::assert_equal(y.destPort_,40000U);
+    xju::assert_equal(y.fromMs_,1700000000123);
+    xju::assert_equal(y.toMs_,1700000001123);
+    xju::assert_equal(y.flows_,1U);
+    xju::assert_equal(y.packets_,1U);
+    xju::assert_equal(y.bytes_,80U);
+  }
+  i=log.next(i);
+  xju::assert_equal(MMapLogSink::type(log,i),MMapLogSink::EXPORTER);
+  {
+    auto const& y(log.get<MMapLogSink::Exporter>(i));
+    xju::assert_equal(y.address_,0x0a000009U);
+    xju::assert_equal(y.port_,2055U);
+    xju::assert_equal(y.domain_,0x102U);
+    xju::assert_equal(y.toMs_,1700000001123);
+    xju::assert_equal(y.stats_.datagrams_,1U);
+    xju::assert_equal(y.stats_.units_,30U);
+  }
+  i=log.next(i);
+  xju::assert_equal(MMapLogSink::type(log,i),MMapLogSink::COLLECTOR);
+  {
+    auto const& y(log.get<MMapLogSink::Collector>(i));
+    xju::assert_equal(y.toMs_,1700000001123);
+    xju::assert_equal(y.malformed_,2U);
+    xju::assert_equal(y.drops_,3U);
+  }
+  i=log.next(i);
+  xju::assert_equal(MMapLogSink::type(log,i),MMapLogSink::COLLECTOR);
+  xju::assert_equal(log.get<MMapLogSink::Collector>(i).drops_,4U);
+  xju::assert_equal(log.next(i),log.end());
+  rm(f);
+}
+
+}
+}
+
+using namespace xju::netflow;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
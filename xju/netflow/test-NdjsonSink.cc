@@ -0,0 +1,93 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/NdjsonSink.hh>
+
+#include <iostream>
+#include <sstream>
+#include <xju/assert.hh>
+#include <xju/unix_epoch.hh>
+
+namespace xju
+{
+namespace netflow
+{
+
+Report report()
+{
+  Report result{xju::unix_epoch()+std::chrono::milliseconds(1700000000123),
+                xju::unix_epoch()+std::chrono::milliseconds(1700000001123),
+                {},{},2,3};
+  result.flows_.add(FlowKey{xju::ip::Protocol(6),
+                            xju::ip::v4::Address("10.0.0.1"),
+                            xju::ip::Port(33000),
+                            xju::ip::v4::Address("10.0.0.2"),
+                            xju::ip::Port(443)},
+                    10,5000);
+  result.flows_.add(FlowKey{xju::ip::Protocol(6),
+                            xju::ip::v4::Address("10.0.0.1"),
+                            xju::ip::Port(33000),
+                            xju::ip::v4::Address("10.0.0.2"),
+                            xju::ip::Port(443)},
+                    1,40);
+  SequenceGaps g;
+  g.update(0,30);
+  g.update(40,30);
+  result.exporters_.insert({Exporter{xju::ip::v4::Address("10.0.0.9"),
+                                     xju::ip::Port(2055),
+                                     1},
+                            g.stats()});
+  return result;
+}
+
+void test1() {
+  std::ostringstream s;
+  NdjsonSink x(s);
+  x.report(report());
+  xju::assert_equal(s.str(),
+                    "{\"type\":\"flow\",\"fromMs\":1700000000123,"
+                    "\"toMs\":1700000001123,\"protocol\":6,"
+                    "\"src\":\"10.0.0.1\",\"srcPort\":33000,"
+                    "\"dest\":\"10.0.0.2\",\"destPort\":443,"
+                    "\"flows\":2,\"packets\":11,\"bytes\":5040}\n"
+                    "{\"type\":\"exporter\",\"toMs\":1700000001123,"
+                    "\"address\":\"10.0.0.9\",\"port\":2055,\"domain\":1,"
+                    "\"datagrams\":2,\"units\":60,\"lost\":10,\"late\":0,"
+                    "\"restarts\":0}\n"
+                    "{\"type\":\"collector\",\"toMs\":1700000001123,"
+                    "\"malformed\":2,\"drops\":3}\n");
+}
+
+// stream failure
+void test2() {
+  std::ostringstream s;
+  s.setstate(std::ios::badbit);
+  NdjsonSink x(s);
+  try{
+    x.report(report());
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to write report of 1 flows and 1 exporters as newline-delimited JSON because\nstream failed.");
+  }
+}
+
+}
+}
+
+using namespace xju::netflow;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/SequenceGaps.hh>
+
+#include <iostream>
+#include <sstream>
+#include <xju/assert.hh>
+
+namespace xju
+{
+namespace netflow
+{
+
+std::string str(SequenceGaps const& x)
+{
+  std::ostringstream s;
+  s << x.stats();
+  return s.str();
+}
+
+// in order, lost, late, restart
+void test1() {
+  SequenceGaps x;
+  x.update(1000,30);
+  x.update(1030,30);
+  x.update(1060,10);
+  xju::assert_equal(str(x),"3 datagrams, 70 units, 0 lost, 0 late, 0 restarts");
+  x.update(1100,30);
+  xju::assert_equal(str(x),"4 datagrams, 100 units, 30 lost, 0 late, 0 restarts");
+  x.update(1070,30);
+  xju::assert_equal(str(x),"5 datagrams, 130 units, 0 lost, 1 late, 0 restarts");
+  x.update(1130,1);
+  xju::assert_equal(str(x),"6 datagrams, 131 units, 0 lost, 1 late, 0 restarts");
+  // nothing lost, so cannot be late
+  x.update(0,5);
+  xju::assert_equal(str(x),"7 datagrams, 136 units, 0 lost, 1 late, 1 restarts");
+  x.update(5,5);
+  xju::assert_equal(str(x),"8 datagrams, 141 units, 0 lost, 1 late, 1 restarts");
+}
+
+// wrap, far back
+void test2() {
+  SequenceGaps x(10);
+  x.update(0xfffffff0,0x10);
+  x.update(0,5);
+  x.update(0x20,1);
+  xju::assert_equal(str(x),"3 datagrams, 22 units, 27 lost, 0 late, 0 restarts");
+  // further back than 10
+  x.update(0xfffffff0,1);
+  xju::assert_equal(str(x),"4 datagrams, 23 units, 27 lost, 0 late, 1 restarts");
+  x.update(0xfffffff1,1);
+  xju::assert_equal(str(x),"5 datagrams, 24 units, 27 lost, 0 late, 1 restarts");
+}
+
+}
+}
+
+using namespace xju::netflow;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
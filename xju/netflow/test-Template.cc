@@ -0,0 +1,130 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/Template.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+
+namespace xju
+{
+namespace netflow
+{
+
+// fixed length: offsets, widths, skipped fields
+void test1() {
+  Template const t({{8,4,0},       // SRC_ADDRESS
+                    {12,4,0},      // DEST_ADDRESS
+                    {99,3,0},      // unknown
+                    {7,2,0},       // SRC_PORT
+                    {11,2,0},      // DEST_PORT
+                    {4,1,0},       // PROTOCOL
+                    {1,8,0},       // BYTES
+                    {2,4,0},       // PACKETS
+                    {7,2,0},       // SRC_PORT again, skipped
+                    {10,4,9},      // enterprise field, skipped
+                    {15,16,0}},    // too wide, skipped
+                   false);
+  xju::assert_equal(t.options(),false);
+  xju::assert_equal(t.variable(),false);
+  xju::assert_equal(t.length(),50U);
+  xju::assert_equal(t.minLength(),50U);
+  xju::assert_equal(t.offsets()[Template::SRC_ADDRESS],0U);
+  xju::assert_equal(t.offsets()[Template::DEST_ADDRESS],4U);
+  xju::assert_equal(t.offsets()[Template::SRC_PORT],11U);
+  xju::assert_equal(t.offsets()[Template::DEST_PORT],13U);
+  xju::assert_equal(t.offsets()[Template::PROTOCOL],15U);
+  xju::assert_equal(t.offsets()[Template::BYTES],16U);
+  xju::assert_equal(t.offsets()[Template::PACKETS],24U);
+  xju::assert_equal((int)t.width(Template::SRC_PORT),2);
+  xju::assert_equal((int)t.width(Template::BYTES),8);
+  xju::assert_equal((int)t.width(Template::INPUT),0);
+  xju::assert_equal((int)t.width(Template::NEXT_HOP),0);
+
+  uint8_t const x[]={0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09};
+  xju::assert_equal(Template::read(x,0),0U);
+  xju::assert_equal(Template::read(x,1),0x01U);
+  xju::assert_equal(Template::read(x,2),0x0102U);
+  xju::assert_equal(Template::read(x,3),0x010203U);
+  xju::assert_equal(Template::read(x,4),0x01020304U);
+  xju::assert_equal(Template::read(x,8),0x0102030405060708ULL);
+}
+
+// variable length
+void test2() {
+  Template const t({{8,4,0},                  // SRC_ADDRESS
+                    {82,Template::VARIABLE,0},// interfaceName
+                    {7,2,0},                  // SRC_PORT
+                    {83,Template::VARIABLE,0},// interfaceDescription
+                    {1,4,0}},                 // BYTES
+                   true);
+  xju::assert_equal(t.options(),true);
+  xju::assert_equal(t.variable(),true);
+  xju::assert_equal(t.minLength(),12U);
+  uint16_t offsets[Template::FIELDS];
+  {
+    uint8_t const x[]={10,0,0,1,
+                       3,'e','t','h',
+                       0x01,0xbb,
+                       255,0,2,'a','b',
+                       0,0,1,0,
+                       0xff};
+    xju::assert_equal(t.locate(x,sizeof(x),offsets),sizeof(x)-1);
+    xju::assert_equal(offsets[Template::SRC_ADDRESS],0U);
+    xju::assert_equal(offsets[Template::SRC_PORT],8U);
+    xju::assert_equal(offsets[Template::BYTES],15U);
+    xju::assert_equal(Template::read(x+offsets[Template::BYTES],4),256U);
+    try{
+      t.locate(x,sizeof(x)-2,offsets);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"record of 19 bytes extends beyond end of set (18 bytes remain).");
+    }
+  }
+  {
+    uint8_t const x[]={10,0,0,1,
+                       0,
+                       0x01,0xbb,
+                       255};
+    try{
+      t.locate(x,sizeof(x),offsets);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"variable-length field's length is beyond end of set.");
+    }
+  }
+}
+
+// empty
+void test3() {
+  try{
+    Template const t({{82,0,0}},false);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to compile template of 1 fields because\nrecords would be empty.");
+  }
+}
+
+}
+}
+
+using namespace xju::netflow;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,331 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/TemplateDecoder.hh>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <xju/assert.hh>
+#include <xju/unix_epoch.hh>
+#include <xju/Optional.hh>
+
+namespace xju
+{
+namespace netflow
+{
+
+// builds an export datagram
+class Builder
+{
+public:
+  std::vector<uint8_t> x_;
+
+  Builder& u8(uint8_t const v)
+  {
+    x_.push_back(v);
+    return *this;
+  }
+  Builder& u16(uint16_t const v)
+  {
+    return u8(v>>8).u8(v);
+  }
+  Builder& u32(uint32_t const v)
+  {
+    return u16(v>>16).u16(v);
+  }
+  // v9 header (count not checked)
+  Builder& v9(uint32_t const upTime,
+              uint32_t const secs,
+              uint32_t const sequence,
+              uint32_t const sourceId)
+  {
+    return u16(9).u16(0).u32(upTime).u32(secs).u32(sequence).u32(sourceId);
+  }
+  // IPFIX header, length filled in by end()
+  Builder& ipfix(uint32_t const secs,
+                 uint32_t const sequence,
+                 uint32_t const domain)
+  {
+    return u16(10).u16(0).u32(secs).u32(sequence).u32(domain);
+  }
+  // start set, length filled in by endSet()
+  Builder& set(uint16_t const id)
+  {
+    set_=x_.size();
+    return u16(id).u16(0);
+  }
+  Builder& endSet()
+  {
+    x_[set_+2]=(x_.size()-set_)>>8;
+    x_[set_+3]=(x_.size()-set_);
+    return *this;
+  }
+  std::vector<uint8_t> const& end()
+  {
+    if (x_[1]==10){
+      x_[2]=x_.size()>>8;
+      x_[3]=x_.size();
+    }
+    return x_;
+  }
+private:
+  size_t set_=0;
+};
+
+std::pair<xju::ip::v4::Address,xju::ip::Port> const sender(
+  xju::ip::v4::Address("10.0.0.99"),xju::ip::Port(2055));
+
+typedef std::vector<std::string> Records;
+
+// decode x with d, returning records as strings
+Records decode(TemplateDecoder& d,
+               std::vector<uint8_t> const& x,
+               xju::Optional<TemplateDecoder::Message>& m)
+{
+  Records result;
+  m=d.decode(sender,x.data(),x.size(),
+             [&](Exporter const& e, DataRecord const& r){
+               std::ostringstream s;
+               s << e << " " << r.key() << " " << r.packets() << " "
+                 << r.bytes();
+               result.push_back(s.str());
+             });
+  return result;
+}
+
+std::string str(TemplateDecoder const& d)
+{
+  std::ostringstream s;
+  s << d.stats();
+  return s.str();
+}
+
+// v9: template and data together, then data alone
+void test1() {
+  TemplateDecoder d;
+  xju::Optional<TemplateDecoder::Message> m;
+  Records const r1(
+    decode(d,
+           Builder().v9(60000,1000000,7,3)
+           .set(0)
+           .u16(256).u16(6)
+           .u16(8).u16(4).u16(12).u16(4).u16(4).u16(1)
+           .u16(7).u16(2).u16(11).u16(2).u16(2).u16(4)
+           .u16(0)  // padding
+           .endSet()
+           .set(256)
+           .u32(0x0a000001).u32(0x0a000002).u8(6).u16(33000).u16(443).u32(3)
+           .u32(0x0a000003).u32(0x0a000004).u8(17).u16(53).u16(5353).u32(1)
+           .u8(0).u8(0).u8(0)  // padding
+           .endSet()
+           .end(),
+           m));
+  xju::assert_equal(r1,Records({
+        "10.0.0.99:2055/3 6 10.0.0.1:33000 > 10.0.0.2:443 3 0",
+        "10.0.0.99:2055/3 17 10.0.0.3:53 > 10.0.0.4:5353 1 0"}));
+  xju::assert_equal(m.value().version_,9U);
+  xju::assert_equal(m.value().exporter_,
+                    Exporter{sender.first,sender.second,3});
+  xju::assert_equal(m.value().exportTime_,
+                    xju::unix_epoch()+std::chrono::seconds(1000000));
+  xju::assert_equal(m.value().sysUpTime_,std::chrono::milliseconds(60000));
+  xju::assert_equal(m.value().sequence_,7U);
+  xju::assert_equal(m.value().units_,1U);
+
+  Records const r2(
+    decode(d,
+           Builder().v9(61000,1000001,8,3)
+           .set(256)
+           .u32(0x0a000005).u32(0x0a000006).u8(1).u16(0).u16(0).u32(2)
+           .endSet()
+           .end(),
+           m));
+  xju::assert_equal(r2,Records({
+        "10.0.0.99:2055/3 1 10.0.0.5:0 > 10.0.0.6:0 2 0"}));
+  xju::assert_equal(d.templates(),1U);
+  xju::assert_equal(str(d),"2 messages, 1 templates, 0 withdrawals, 3 records, 0 options records, 0 sets with unknown template");
+}
+
+// v9: data before its template, templates per source id, options,
+// template replaced
+void test2() {
+  TemplateDecoder d;
+  xju::Optional<TemplateDecoder::Message> m;
+  auto const data([](uint32_t const sourceId){
+      return Builder().v9(0,0,0,sourceId)
+        .set(300)
+        .u16(443).u32(1000).u32(0x0a000001)
+        .endSet()
+        .end();
+    });
+  xju::assert_equal(decode(d,data(1),m),Records());
+  xju::assert_equal(str(d),"1 messages, 0 templates, 0 withdrawals, 0 records, 0 options records, 1 sets with unknown template");
+
+  // template and options template, and options data
+  xju::assert_equal(
+    decode(d,
+           Builder().v9(0,0,0,1)
+           .set(0)
+           .u16(300).u16(3)
+           .u16(11).u16(2).u16(1).u16(4).u16(8).u16(4)
+           .endSet()
+           .set(1)
+           .u16(301).u16(4).u16(8)
+           .u16(1).u16(4)
+           .u16(36).u16(2).u16(37).u16(2)
+           .u16(0)  // padding
+           .endSet()
+           .set(301)
+           .u32(1).u16(60).u16(30)
+           .u32(1).u16(60).u16(30)
+           .endSet()
+           .end(),
+           m),
+    Records());
+  xju::assert_equal(decode(d,data(1),m),Records({
+        "10.0.0.99:2055/1 0 10.0.0.1:0 > 0.0.0.0:443 0 1000"}));
+  // other source id has no templates
+  xju::assert_equal(decode(d,data(2),m),Records());
+  xju::assert_equal(str(d),"4 messages, 2 templates, 0 withdrawals, 1 records, 2 options records, 2 sets with unknown template");
+
+  // replace template
+  decode(d,
+         Builder().v9(0,0,0,1)
+         .set(0)
+         .u16(300).u16(2)
+         .u16(7).u16(2).u16(2).u16(8)
+         .endSet()
+         .end(),
+         m);
+  xju::assert_equal(decode(d,data(1),m),Records({
+        "10.0.0.99:2055/1 0 0.0.0.0:443 > 0.0.0.0:0 4295135068161 0"}));
+  xju::assert_equal(d.templates(),2U);
+}
+
+// IPFIX: enterprise and variable-length fields, units, withdrawal
+void test3() {
+  TemplateDecoder d;
+  xju::Optional<TemplateDecoder::Message> m;
+  Records const r1(
+    decode(d,
+           Builder().ipfix(2000000,100,5)
+           .set(2)
+           .u16(400).u16(5)
+           .u16(8).u16(4)
+           .u16(0x8000|8).u16(4).u32(9)   // enterprise 9's field 8
+           .u16(82).u16(65535)            // interfaceName
+           .u16(2).u16(8)
+           .u16(12).u16(4)
+           .u16(401).u16(2)
+           .u16(1).u16(8).u16(4).u16(1)
+           .endSet()
+           .set(400)
+           .u32(0x0a000001).u32(99).u8(3).u8('e').u8('t').u8('h')
+           .u32(0).u32(5).u32(0x0a000002)
+           .u32(0x0a000003).u32(99).u8(255).u16(1).u8('x')
+           .u32(0).u32(6).u32(0x0a000004)
+           .endSet()
+           .set(401)
+           .u32(0).u32(1500).u8(6)
+           .endSet()
+           .end(),
+           m));
+  xju::assert_equal(r1,Records({
+        "10.0.0.99:2055/5 0 10.0.0.1:0 > 10.0.0.2:0 5 0",
+        "10.0.0.99:2055/5 0 10.0.0.3:0 > 10.0.0.4:0 6 0",
+        "10.0.0.99:2055/5 6 0.0.0.0:0 > 0.0.0.0:0 0 1500"}));
+  xju::assert_equal(m.value().version_,10U);
+  xju::assert_equal(m.value().exporter_,
+                    Exporter{sender.first,sender.second,5});
+  xju::assert_equal(m.value().exportTime_,
+                    xju::unix_epoch()+std::chrono::seconds(2000000));
+  xju::assert_equal(m.value().sequence_,100U);
+  xju::assert_equal(m.value().units_,3U);
+
+  // withdraw 400, then all
+  decode(d,
+         Builder().ipfix(0,103,5)
+         .set(2).u16(400).u16(0).endSet()
+         .end(),
+         m);
+  xju::assert_equal(m.value().units_,0U);
+  xju::assert_equal(d.templates(),1U);
+  decode(d,
+         Builder().ipfix(0,103,5)
+         .set(2).u16(2).u16(0).endSet()
+         .end(),
+         m);
+  xju::assert_equal(d.templates(),0U);
+  xju::assert_equal(str(d),"3 messages, 2 templates, 2 withdrawals, 3 records, 0 options records, 0 sets with unknown template");
+}
+
+// malformed
+void test4() {
+  TemplateDecoder d;
+  xju::Optional<TemplateDecoder::Message> m;
+  try{
+    decode(d,Builder().u16(5).u16(0).end(),m);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to decode 4-byte netflow v9/IPFIX datagram from 10.0.0.99:2055 because\nversion is 5, not 9 or 10 (IPFIX).");
+  }
+  try{
+    auto x(Builder().v9(0,0,0,1).set(256).u32(0).endSet().end());
+    x[23]=9;
+    decode(d,x,m);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to decode 28-byte netflow v9/IPFIX datagram from 10.0.0.99:2055 because\nset at byte 20 has length 9 but 8 bytes remain.");
+  }
+  try{
+    decode(d,Builder().v9(0,0,0,1).set(0).u16(255).u16(1).u16(1).u16(4)
+           .endSet().end(),m);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to decode 32-byte netflow v9/IPFIX datagram from 10.0.0.99:2055 because\nfailed to read template 255 because\ntemplate id 255 is less than 256.");
+  }
+  try{
+    decode(d,Builder().ipfix(0,0,1).set(2).u16(256).u16(2).u16(1).u16(4)
+           .endSet().end(),m);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to decode 28-byte netflow v9/IPFIX datagram from 10.0.0.99:2055 because\nfailed to read template 256 because\nfield 1 of 2 is beyond end of set.");
+  }
+  try{
+    decode(d,Builder().ipfix(0,0,1).set(2).u16(256).u16(1).u16(82)
+           .u16(65535).endSet()
+           .set(256).u8(5).u8('a').endSet().end(),m);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to decode 34-byte netflow v9/IPFIX datagram from 10.0.0.99:2055 because\nrecord of 6 bytes extends beyond end of set (2 bytes remain).");
+  }
+  xju::assert_equal(str(d),"0 messages, 1 templates, 0 withdrawals, 0 records, 0 options records, 0 sets with unknown template");
+}
+
+}
+}
+
+using namespace xju::netflow;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// Flows/s of netflow v5 collection:
+//   - single core, decode() then aggregate, vs aggregating from
+//     Datagram views in place
+//   - end to end over loopback, a sender blasting full datagrams at a
+//     Collector with 2 workers
+// ... compared with a target of 500k flows/s.
+//
+#include <xju/netflow/v5/Collector.hh>
+#include <xju/netflow/v5/Datagram.hh>
+#include <xju/netflow/v5.hh>
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <xju/assert.hh>
+#include <xju/steadyNow.hh>
+#include <xju/unix_epoch.hh>
+
+namespace xju
+{
+namespace netflow
+{
+namespace v5
+{
+
+// full (30 record) datagram number n of flows among 4096 keys
+std::vector<uint8_t> datagram(uint32_t const n)
+{
+  auto const t(xju::unix_epoch()+std::chrono::seconds(1700000000));
+  std::vector<Flow> flows;
+  for(uint32_t i=0; i!=30; ++i){
+    uint32_t const k((n*30+i)%4096);
+    flows.push_back(Flow(xju::ip::v4::Address(0xc0a80000+k%1024),
+                         xju::ip::Port(40000+k),
+                         xju::ip::v4::Address(0x0a000001+k%16),
+                         xju::ip::Port(443),
+                         1,2,xju::ip::v4::Address(0),
+                         t,t,
+                         10,1500,
+                         0,6,0,0,0,0,0));
+  }
+  return encode({Header(std::chrono::milliseconds(1000),t,n*30),flows});
+}
+
+void report(std::string const& name, uint64_t const flows,
+            double const seconds)
+{
+  double const fps(flows/seconds);
+  std::cout << name << ": " << flows << " flows, " << fps/1e6
+            << "M flows/s; target 500k flows/s "
+            << (fps>=5e5?"met":"NOT met") << std::endl;
+}
+
+class CountingSink : public Sink
+{
+public:
+  CountingSink() noexcept:
+      flows_(0),
+      drops_(0)
+  {
+  }
+  void report(Report const& x) override
+  {
+    uint64_t n(0);
+    for(auto const& f: x.flows_.totals()){
+      n+=f.second.flows_;
+    }
+    flows_+=n;
+    drops_=x.drops_;
+  }
+  std::atomic<uint64_t> flows_;
+  std::atomic<uint64_t> drops_;
+};
+
+}
+}
+}
+
+using namespace xju::netflow;
+using namespace xju::netflow::v5;
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::vector<uint8_t> > datagrams;
+  for(uint32_t i=0; i!=1024; ++i){
+    datagrams.push_back(datagram(i));
+  }
+  size_t const N(200000);
+  {
+    Aggregate a;
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t i=0; i!=N; ++i){
+      auto const x(decode(datagrams[i%datagrams.size()]));
+      for(auto const& f: x.second){
+        a.add(FlowKey{xju::ip::Protocol(f.ipProtocol_),
+                      f.srcAddress_,f.srcPort_,
+                      f.destAddress_,f.destPort_},
+              f.packetsInFlow_,f.bytesInFlow_);
+      }
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    xju::assert_equal(a.size(),4096U);
+    report("decode()",N*30,std::chrono::duration<double>(t2-t1).count());
+  }
+  {
+    Aggregate a;
+    auto const t1(std::chrono::steady_clock::now());
+    for(size_t i=0; i!=N; ++i){
+      auto const& x(datagrams[i%datagrams.size()]);
+      Datagram const d(x.data(),x.size());
+      for(auto const r: d){
+        a.add(FlowKey{r.ipProtocol(),
+                      r.srcAddress(),r.srcPort(),
+                      r.destAddress(),r.destPort()},
+              r.packetsInFlow(),r.bytesInFlow());
+      }
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    xju::assert_equal(a.size(),4096U);
+    report("Datagram",N*30,std::chrono::duration<double>(t2-t1).count());
+  }
+  {
+    xju::ip::UDPSocket socket;
+    CountingSink sink;
+    uint64_t sent(0);
+    std::chrono::steady_clock::time_point t1;
+    {
+      Collector c(socket,sink,std::cerr,2,std::chrono::milliseconds(100));
+      xju::ip::UDPSocket sender;
+      xju::ip::UDPSocket::Batch b(64,Datagram::HEADER_SIZE+
+                                  30*Datagram::RECORD_SIZE);
+      auto const to(std::make_pair(xju::ip::v4::Address("127.0.0.1"),
+                                   socket.port()));
+      t1=std::chrono::steady_clock::now();
+      for(size_t i=0; i!=N/64; ++i){
+        b.clear();
+        for(size_t j=0; j!=64; ++j){
+          auto const& x(datagrams[(i*64+j)%datagrams.size()]);
+          b.push_back(to,x.data(),x.size());
+        }
+        sender.sendMany(b,xju::steadyNow()+std::chrono::seconds(1));
+        sent+=64*30;
+      }
+      // let collector catch up
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    auto const t2(std::chrono::steady_clock::now());
+    report("end to end",sink.flows_,
+           std::chrono::duration<double>(t2-t1).count());
+    std::cout << "  (" << sent << " flows sent, " << sink.drops_
+              << " datagrams dropped by kernel)" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/v5/Collector.hh>
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <xju/assert.hh>
+#include <xju/steadyNow.hh>
+#include <xju/unix_epoch.hh>
+#include <xju/Lock.hh>
+#include <xju/netflow/v5.hh>
+
+namespace xju
+{
+namespace netflow
+{
+namespace v5
+{
+
+// totals reports
+class TestSink : public Sink
+{
+public:
+  TestSink() noexcept:
+      reports_(0),
+      malformed_(0)
+  {
+  }
+
+  void report(Report const& x) override
+  {
+    xju::Lock l(guard_);
+    ++reports_;
+    for(auto const& f: x.flows_.totals()){
+      FlowTotals& t(flows_[f.first]);
+      t.flows_+=f.second.flows_;
+      t.packets_+=f.second.packets_;
+      t.bytes_+=f.second.bytes_;
+    }
+    exporters_=x.exporters_;
+    malformed_=x.malformed_;
+  }
+
+  xju::Mutex guard_;
+  size_t reports_;
+  std::map<FlowKey,FlowTotals> flows_;
+  std::map<Exporter,SequenceGaps::Stats> exporters_;
+  uint64_t malformed_;
+};
+
+FlowKey key(uint32_t i)
+{
+  return FlowKey{xju::ip::Protocol(6),
+                 xju::ip::v4::Address(0xc0a80000+i),
+                 xju::ip::Port(40000+i),
+                 xju::ip::v4::Address(0x0a000001),
+                 xju::ip::Port(443)};
+}
+
+std::vector<uint8_t> datagram(uint32_t const sequence,
+                              std::vector<uint32_t> const& keys,
+                              uint8_t const engineId=0)
+{
+  auto const t(xju::unix_epoch()+std::chrono::seconds(1700000000));
+  std::vector<Flow> flows;
+  for(auto i: keys){
+    FlowKey const k(key(i));
+    flows.push_back(Flow(k.srcAddress_,k.srcPort_,
+                         k.destAddress_,k.destPort_,
+                         1,2,xju::ip::v4::Address(0),
+                         t,t,
+                         i+1,(i+1)*100,
+                         0,k.protocol_.value(),0,0,0,0,0));
+  }
+  auto result(
+    encode({Header(std::chrono::milliseconds(1000),t,sequence),flows}));
+  result[21]=engineId;
+  return result;
+}
+
+// aggregate over batches and workers, with loss and malformed
+// accounting
+void test1() {
+  xju::ip::UDPSocket socket;
+  TestSink sink;
+  std::ostringstream log;
+  Collector c(socket,sink,log,2,std::chrono::milliseconds(20),4);
+  xju::ip::UDPSocket sender;
+  auto const to(std::make_pair(xju::ip::v4::Address("127.0.0.1"),
+                               socket.port()));
+  auto const send([&](std::vector<uint8_t> const& x){
+      sender.sendTo(to,x.data(),x.size(),
+                    xju::steadyNow()+std::chrono::seconds(1));
+    });
+  size_t const N(100);
+  uint32_t sequence(0);
+  for(size_t i=0; i!=N; ++i){
+    std::vector<uint32_t> keys{0,1,2,(uint32_t)(i%10)};
+    send(datagram(sequence,keys));
+    sequence+=keys.size();
+    if (i==50){
+      // lose 7 flows
+      sequence+=7;
+    }
+  }
+  // another exporter (engine) at same address
+  send(datagram(1000,{3},1));
+  // wrong version
+  auto bad(datagram(0,{1}));
+  bad[1]=9;
+  send(bad);
+  // too long
+  send(std::vector<uint8_t>(3000,5));
+
+  std::map<FlowKey,FlowTotals> expected;
+  for(size_t i=0; i!=N; ++i){
+    for(uint32_t k: {0U,1U,2U,(uint32_t)(i%10)}){
+      FlowTotals& t(expected[key(k)]);
+      ++t.flows_;
+      t.packets_+=k+1;
+      t.bytes_+=(k+1)*100;
+    }
+  }
+  ++expected[key(3)].flows_;
+  expected[key(3)].packets_+=4;
+  expected[key(3)].bytes_+=400;
+  auto const deadline(xju::steadyNow()+std::chrono::seconds(5));
+  while(true){
+    {
+      xju::Lock l(sink.guard_);
+      if (sink.flows_.size()==expected.size() &&
+          sink.malformed_==2 &&
+          sink.exporters_.size()==2){
+        for(auto const& e: expected){
+          xju::assert_equal(sink.flows_.at(e.first),e.second);
+        }
+        Exporter const e0{xju::ip::v4::Address("127.0.0.1"),
+                          sender.port(),0};
+        Exporter const e1{xju::ip::v4::Address("127.0.0.1"),
+                          sender.port(),1};
+        auto const& s0(sink.exporters_.at(e0));
+        xju::assert_equal(s0.datagrams_,N);
+        xju::assert_equal(s0.units_,N*4);
+        xju::assert_equal(s0.lost_,7U);
+        xju::assert_equal(s0.late_,0U);
+        xju::assert_equal(s0.restarts_,0U);
+        xju::assert_equal(sink.exporters_.at(e1).units_,1U);
+        break;
+      }
+    }
+    xju::assert_less(xju::steadyNow(),deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  xju::assert_equal(log.str(),"");
+}
+
+}
+}
+}
+
+using namespace xju::netflow::v5;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
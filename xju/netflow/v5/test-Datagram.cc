@@ -0,0 +1,139 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/netflow/v5/Datagram.hh>
+
+#include <iostream>
+#include <vector>
+#include <xju/assert.hh>
+#include <xju/unix_epoch.hh>
+
+namespace xju
+{
+namespace netflow
+{
+namespace v5
+{
+
+Flow flow(uint32_t i, std::chrono::system_clock::time_point routerStart)
+{
+  return Flow(xju::ip::v4::Address(0xc0a80000+i),
+              xju::ip::Port(40000+i),
+              xju::ip::v4::Address(0x0a000001),
+              xju::ip::Port(443),
+              3,9,
+              xju::ip::v4::Address(0xbc362101),
+              routerStart+std::chrono::milliseconds(1000+i),
+              routerStart+std::chrono::milliseconds(2000+i),
+              i+1,(i+1)*1000,
+              0x1b,6,0x10,24,16,
+              0x23,0x8077);
+}
+
+// view gives same fields as decode()
+void test1() {
+  auto const routerTime(xju::unix_epoch()+std::chrono::seconds(0x81234567)+
+                        std::chrono::nanoseconds(0x02abcdef));
+  Header const h(std::chrono::milliseconds(0x80004520),routerTime,
+                 0xfffffffe);
+  std::vector<Flow> flows;
+  for(uint32_t i=0; i!=30; ++i){
+    flows.push_back(flow(i,routerTime-h.routerUpTime_));
+  }
+  auto const x(encode({h,flows}));
+  auto const y(decode(x));
+  Datagram const d(x.data(),x.size());
+  xju::assert_equal(d.count(),30U);
+  xju::assert_equal(d.routerUpTime(),y.first.routerUpTime_);
+  xju::assert_equal(d.routerTime(),y.first.routerTime_);
+  xju::assert_equal(d.sequence(),0xfffffffeU);
+  xju::assert_equal(d.engineType(),0U);
+  xju::assert_equal(d.engineId(),0U);
+  xju::assert_equal(d.samplingInterval(),0U);
+  xju::assert_equal(d.header().flowNumberOfFirstFlow_,
+                    y.first.flowNumberOfFirstFlow_);
+  size_t n(0);
+  for(auto const r: d){
+    Flow const& f(y.second[n]);
+    xju::assert_equal(r.srcAddress(),f.srcAddress_);
+    xju::assert_equal(r.destAddress(),f.destAddress_);
+    xju::assert_equal(r.nextHopRouter(),f.nextHopRouter_);
+    xju::assert_equal(r.inputInterfaceSnmpIndex(),f.inputInterfaceSnmpIndex_);
+    xju::assert_equal(r.outputInterfaceSnmpIndex(),
+                      f.outputInterfaceSnmpIndex_);
+    xju::assert_equal(r.packetsInFlow(),f.packetsInFlow_);
+    xju::assert_equal(r.bytesInFlow(),f.bytesInFlow_);
+    xju::assert_equal(r.srcPort(),f.srcPort_);
+    xju::assert_equal(r.destPort(),f.destPort_);
+    xju::assert_equal(r.tcpFlags(),f.tcpFlags_);
+    xju::assert_equal(r.ipProtocol().value(),f.ipProtocol_);
+    xju::assert_equal(r.ipTOS(),f.ipTOS_);
+    xju::assert_equal(r.bgpSrcAs(),f.bgpSrcAs_);
+    xju::assert_equal(r.bgpDstAs(),f.bgpDstAs_);
+    xju::assert_equal(r.srcNetmaskBits(),f.srcNetmaskBits_);
+    xju::assert_equal(r.dstNetmaskBits(),f.dstNetmaskBits_);
+    Flow const g(d.flow(r));
+    xju::assert_equal(g.flowStart_,f.flowStart_);
+    xju::assert_equal(g.flowEnd_,f.flowEnd_);
+    xju::assert_equal(g.bytesInFlow_,f.bytesInFlow_);
+    ++n;
+  }
+  xju::assert_equal(n,30U);
+  xju::assert_equal(d[29].srcAddress(),xju::ip::v4::Address(0xc0a8001d));
+
+  // no records
+  auto const z(encode({h,{}}));
+  Datagram const e(z.data(),z.size());
+  xju::assert_equal(e.count(),0U);
+  xju::assert_equal(e.begin(),e.end());
+}
+
+// malformed
+void test2() {
+  auto const t(xju::unix_epoch()+std::chrono::seconds(1));
+  Header const h(std::chrono::milliseconds(1000),t,0);
+  auto x(encode({h,{flow(0,t),flow(1,t)}}));
+  try{
+    Datagram const d(x.data(),x.size()-1);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to validate netflow v5 datagram of 119 bytes because\nheader says there are 2 records, which need 120 bytes.");
+  }
+  try{
+    Datagram const d(x.data(),23);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to validate netflow v5 datagram of 23 bytes because\nheader needs 24 bytes.");
+  }
+  x[1]=9;
+  try{
+    Datagram const d(x.data(),x.size());
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to validate netflow v5 datagram of 120 bytes because\ndata is netflow version 9, not 5.");
+  }
+}
+
+}
+}
+}
+
+using namespace xju::netflow::v5;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
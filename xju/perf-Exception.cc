@@ -0,0 +1,160 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// Compare cost of a deep decode failure, that is caught and discarded
+// by a caller trying alternative decoders, where each level adds
+// context eagerly (std::ostringstream) vs lazily (addLazyContext).
+//
+// Also time a real snmp decode failure, a v2c get request whose value
+// has an unknown type, where decodeValue adds context lazily and the
+// request decoder eagerly, against decoding the same request intact.
+//
+#include <xju/Exception.hh>
+
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstdint>
+#include <xju/assert.hh>
+#include <xju/snmp/decodeSnmpV2cGetRequest.hh>
+#include <vector>
+
+namespace xju
+{
+
+// decode a field at offset at, which fails at depth 0
+void decodeEager(unsigned int depth, size_t at)
+{
+  try {
+    if (depth==0) {
+      throw xju::Exception("end of data", XJU_TRACED);
+    }
+    decodeEager(depth-1, at+2);
+  }
+  catch(xju::Exception& e) {
+    std::ostringstream s;
+    s << "decode field " << depth << " at offset " << at;
+    e.addContext(s.str(), XJU_TRACED);
+    throw;
+  }
+}
+
+void decodeLazy(unsigned int depth, size_t at)
+{
+  try {
+    if (depth==0) {
+      throw xju::Exception("end of data", XJU_TRACED);
+    }
+    decodeLazy(depth-1, at+2);
+  }
+  catch(xju::Exception& e) {
+    e.addLazyContext([depth,at](std::ostream& s){
+        s << "decode field " << depth << " at offset " << at;
+      },{__FILE__,__LINE__});
+    throw;
+  }
+}
+
+template<class F>
+double nsPerFailure(F f, unsigned int depth, unsigned int n)
+{
+  auto const t1(std::chrono::steady_clock::now());
+  for(unsigned int i=0; i!=n; ++i) {
+    try {
+      f(depth, 0);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const&) {
+      // try next decoder...
+    }
+  }
+  auto const t2(std::chrono::steady_clock::now());
+  return std::chrono::duration<double, std::nano>(t2-t1).count()/n;
+}
+
+// get request for .1.3.6.1.4.1.2680.1.2.7.3.2.0, community "private"
+std::vector<uint8_t> const snmpGetRequest{
+  0x30,0x2c,0x02,0x01,0x01,0x04,0x07,0x70,0x72,0x69,0x76,0x61,0x74,0x65,
+  0xA0,0x1E,0x02,0x01,0x01,0x02,0x01,0x00,0x02,0x01,0x00,0x30,0x13,0x30,
+  0x11,0x06,0x0D,0x2B,0x06,0x01,0x04,0x01,0x94,0x78,0x01,0x02,0x07,0x03,
+  0x02,0x00,0x05,0x00};
+
+// ns per decodeSnmpV2cGetRequest(data), which must fail iff fails
+double nsPerSnmpDecode(std::vector<uint8_t> const& data,
+                       bool const fails,
+                       unsigned int n)
+{
+  auto const t1(std::chrono::steady_clock::now());
+  for(unsigned int i=0; i!=n; ++i) {
+    try {
+      xju::snmp::decodeSnmpV2cGetRequest(data);
+      xju::assert_equal(fails,false);
+    }
+    catch(xju::Exception const&) {
+      // try next decoder...
+      xju::assert_equal(fails,true);
+    }
+  }
+  auto const t2(std::chrono::steady_clock::now());
+  return std::chrono::duration<double, std::nano>(t2-t1).count()/n;
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int const n(argc>1?std::stoul(argv[1]):20000);
+  unsigned int const depth(8);
+
+  // same text either way
+  std::string eager, lazy;
+  try {
+    decodeEager(depth, 0);
+  }
+  catch(xju::Exception const& e) {
+    eager=readableRepr(e);
+  }
+  try {
+    decodeLazy(depth, 0);
+  }
+  catch(xju::Exception const& e) {
+    lazy=readableRepr(e);
+  }
+  xju::assert_equal(eager, lazy);
+
+  double const e(nsPerFailure(decodeEager, depth, n));
+  double const l(nsPerFailure(decodeLazy, depth, n));
+  std::cout << "depth " << depth << " decode failure, " << n << " iterations"
+            << std::endl
+            << "  eager context: " << e << "ns per failure" << std::endl
+            << "  lazy context:  " << l << "ns per failure" << std::endl
+            << "  ratio: " << (e/l) << std::endl;
+
+  // value type 0x07 instead of null
+  std::vector<uint8_t> bad(snmpGetRequest);
+  bad[bad.size()-2]=0x07;
+  try {
+    xju::snmp::decodeSnmpV2cGetRequest(bad);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e) {
+    std::cout << "snmp decode failure:" << std::endl
+              << readableRepr(e) << std::endl;
+  }
+  double const o(nsPerSnmpDecode(snmpGetRequest, false, n));
+  double const b(nsPerSnmpDecode(bad, true, n));
+  std::cout << "snmp v2c get request decode, " << n << " iterations"
+            << std::endl
+            << "  intact:     " << o << "ns per decode" << std::endl
+            << "  bad value:  " << b << "ns per failure" << std::endl
+            << "  ratio: " << (b/o) << std::endl;
+  return 0;
+}
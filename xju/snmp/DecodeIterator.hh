@@ -60,13 +60,18 @@ public:
   {
     return at_==data_->end();
   }
+  // offset from start of data
+  size_t offset() const throw()
+  {
+    return at_-data_->begin();
+  }
   std::vector<uint8_t> const* data_;
   std::vector<uint8_t>::const_iterator at_;
 
   friend std::ostream& operator<<(std::ostream& s, 
                                   DecodeIterator const& i) throw()
   {
-    return s << "offset " << (i.at_-i.data_->begin());
+    return s << "offset " << i.offset();
   }
   friend DecodeIterator operator+(DecodeIterator const& i,
                                   int n) throw() {
@@ -53,9 +53,9 @@ std::pair<xju::ip::v4::Address,DecodeIterator> decodeIPv4AddressValue(
       length.second+length.first.value());
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode string at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode string at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -55,9 +55,9 @@ std::pair<uint64_t,DecodeIterator> decodeIntValue(
     return std::make_pair(result,i);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode integer at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode integer at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
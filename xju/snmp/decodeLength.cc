@@ -49,9 +49,9 @@ std::pair<xju::Optional<size_t>,DecodeIterator> decodeLength(
     }
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode length at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode length at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
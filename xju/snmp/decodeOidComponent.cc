@@ -30,9 +30,9 @@ std::pair<uint32_t,DecodeIterator> decodeOidComponent(
     return std::pair<uint32_t,DecodeIterator>(result,i);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode oid copmonent at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode oid copmonent at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
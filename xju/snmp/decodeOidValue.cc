@@ -70,9 +70,9 @@ std::pair<Oid,DecodeIterator> decodeOidValue(
     return std::make_pair(Oid(components),i);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode oid at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode oid at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -32,9 +32,9 @@ decodeSequenceTypeAndLength(DecodeIterator const at) /*throw(
                           length.second);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode sequence type and length at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode sequence type and length at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -45,9 +45,9 @@ std::pair<std::vector<uint8_t>,DecodeIterator> decodeStringValue(
     return std::make_pair(s,length.second+length.first.value());
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode string at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode string at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -54,9 +54,9 @@ std::pair<std::chrono::milliseconds,DecodeIterator> decodeTimeTicksValue(
     return std::make_pair(std::chrono::milliseconds(result*10),i);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode TimeTicks at " << at;
-    e.addContext(s.str(), XJU_TRACED);
+    e.addLazyContext([offset=at.offset()](std::ostream& s){
+        s << "decode TimeTicks at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -52,9 +52,9 @@ std::pair<std::shared_ptr<Value const>, DecodeIterator> decodeValue(
                               l.second+l.first.value());
       }
       catch(xju::Exception& e) {
-        std::ostringstream s;
-        s << "decode null at " << i;
-        e.addContext(s.str(), XJU_TRACED);
+        e.addLazyContext([offset=i.offset()](std::ostream& s){
+            s << "decode null at offset " << offset;
+          },{__FILE__,__LINE__});
         throw;
       }
       break;
@@ -140,9 +140,9 @@ std::pair<std::shared_ptr<Value const>, DecodeIterator> decodeValue(
     throw xju::Exception(s.str(),XJU_TRACED);
   }
   catch(xju::Exception& e) {
-    std::ostringstream s;
-    s << "decode one int/string/oid/null etc value at " << i;
-    e.addContext(s.str(),XJU_TRACED);
+    e.addLazyContext([offset=i.offset()](std::ostream& s){
+        s << "decode one int/string/oid/null etc value at offset " << offset;
+      },{__FILE__,__LINE__});
     throw;
   }
 }
@@ -34,6 +34,9 @@ namespace xju
     const SyscallF3<ssize_t, int, const msghdr*, int> sendmsg={
         "sendmsg",
         ::sendmsg};
+    const SyscallF4<int, int, mmsghdr*, unsigned int, int> sendmmsg={
+        "sendmmsg",
+        ::sendmmsg};
     const SyscallF4<ssize_t, int, void*, size_t, int> recv={
 	"recv",
 	::recv};
@@ -43,6 +46,9 @@ namespace xju
     const SyscallF3<ssize_t, int, struct msghdr*, int> recvmsg={
 	"recvmsg",
 	::recvmsg};
+    const SyscallF5<int, int, mmsghdr*, unsigned int, int, timespec*> recvmmsg={
+	"recvmmsg",
+	::recvmmsg};
     const SyscallF5<int, int, int, int, void*, socklen_t*> getsockopt={
 	"getsockopt",
 	::getsockopt};
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+// SSH packet decode throughput, for small (interactive) and large (bulk
+// transfer) packets, delivered by the buffer in socket-read-sized
+// blocks, compared with byte-at-a-time decode via get8().
+//
+#include <xju/ssh/transport/decodePacket.hh>
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <xju/assert.hh>
+#include <xju/MemIBuf.hh>
+#include <xju/net/istream.hh>
+#include <xju/net/ostream.hh>
+#include <xju/MemOBuf.hh>
+
+namespace xju
+{
+namespace ssh
+{
+namespace transport
+{
+
+// n packets each with bodySize byte body and 4 byte padding
+std::vector<uint8_t> makePackets(size_t n, size_t bodySize)
+{
+  xju::MemOBuf b(64*1024);
+  {
+    xju::net::ostream s(b);
+    std::vector<uint8_t> const body(bodySize,0x5a);
+    for(size_t i=0; i!=n; ++i){
+      s.put32(bodySize+4+1);
+      s.put8(4);
+      s.put(body.begin(),body.end());
+      s.put32(0);
+    }
+  }
+  return std::vector<uint8_t>(b.data().first,b.data().second);
+}
+
+// decode as decodePacket did before bulk copies
+std::pair<std::vector<uint8_t>,Padding> decodePacketBytewise(
+  xju::net::istream& from,
+  size_t const maxBodyBytes)
+{
+  uint32_t const packet_length(
+    ((uint32_t)from.get8()<<24)|((uint32_t)from.get8()<<16)|
+    ((uint32_t)from.get8()<<8)|((uint32_t)from.get8()));
+  uint32_t padding_length(from.get8());
+  uint32_t const body_length=packet_length-padding_length-1;
+  xju::assert_less_equal(body_length,maxBodyBytes);
+  std::vector<uint8_t> body(body_length);
+  for(auto& c: body){
+    c=from.get8();
+  }
+  Padding padding(padding_length);
+  for(auto& c: padding){
+    c=from.get8();
+  }
+  return std::make_pair(body,padding);
+}
+
+// returns MB/s
+template<class F>
+double measure(F f,
+               std::vector<uint8_t> const& packets,
+               size_t n,
+               size_t bodySize,
+               unsigned int repeat)
+{
+  auto const t1(std::chrono::steady_clock::now());
+  for(unsigned int r=0; r!=repeat; ++r){
+    xju::MemIBuf b(packets.begin(),packets.end(),16*1024);
+    xju::net::istream s(b);
+    for(size_t i=0; i!=n; ++i){
+      auto const p(f(s,bodySize));
+      xju::assert_equal(p.first.size(),bodySize);
+    }
+  }
+  auto const t2(std::chrono::steady_clock::now());
+  double const seconds(std::chrono::duration<double>(t2-t1).count());
+  return (packets.size()*repeat)/seconds/1e6;
+}
+
+}
+}
+}
+
+using namespace xju::ssh::transport;
+
+int main(int argc, char* argv[])
+{
+  unsigned int const repeat(argc>1?std::stoul(argv[1]):20);
+  for(size_t bodySize: {64U,1024U,32768U}){
+    size_t const n((16*1024*1024)/bodySize/repeat+1);
+    auto const packets(makePackets(n,bodySize));
+    double const bulk(measure(decodePacket,packets,n,bodySize,repeat));
+    double const bytewise(
+      measure(decodePacketBytewise,packets,n,bodySize,repeat));
+    std::cout << bodySize << "-byte packets, " << n*repeat << " packets"
+              << std::endl
+              << "  decodePacket:       " << bulk << "MB/s" << std::endl
+              << "  byte-at-a-time:     " << bytewise << "MB/s" << std::endl
+              << "  ratio: " << (bulk/bytewise) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,255 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/BufferPool.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/MemOBuf.hh>
+#include <xju/MemIBuf.hh>
+#include <xju/net/ostream.hh>
+#include <xju/net/istream.hh>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <vector>
+
+namespace xju
+{
+
+// hits, misses, size classes, stats
+void test1() {
+  BufferPool p;
+  {
+    auto x(p.lease(10));
+    xju::assert_equal(x.data().size(),0U);
+    xju::assert_equal(x.data().capacity(),256U);
+    x.data().resize(10);
+    auto const s(p.stats());
+    xju::assert_equal(s.hits_,0U);
+    xju::assert_equal(s.misses_,1U);
+    xju::assert_equal(s.leased_,256U);
+    xju::assert_equal(s.cached_,0U);
+  }
+  xju::assert_equal(p.stats().leased_,0U);
+  xju::assert_equal(p.stats().cached_,256U);
+  uint8_t const* d;
+  {
+    auto x(p.lease(256));
+    d=x.data().data();
+    xju::assert_equal(x.data().size(),0U);
+    xju::assert_equal(p.stats().hits_,1U);
+    // different class
+    auto y(p.lease(257));
+    xju::assert_equal(y.data().capacity(),512U);
+    xju::assert_equal(p.stats().misses_,2U);
+    xju::assert_equal(p.stats().highWater_,768U);
+
+    // move
+    BufferPool::Lease z(std::move(x));
+    xju::assert_equal(z.data().data(),d);
+
+    // copy
+    z.data().push_back(7);
+    BufferPool::Lease w(z);
+    xju::assert_not_equal(w.data().data(),z.data().data());
+    xju::assert_equal(w.data(),std::vector<uint8_t>({7}));
+    xju::assert_equal(p.stats().leased_,1024U);
+  }
+  xju::assert_equal(p.stats().leased_,0U);
+  xju::assert_equal(p.stats().cached_,1024U);
+  {
+    // grown buffer returns to larger class
+    auto x(p.lease(1));
+    x.data().resize(1000);
+  }
+  xju::assert_equal(p.stats().leased_,0U);
+  {
+    auto x(p.lease(500));
+    xju::assert_equal(x.data().capacity(),1000U);
+    xju::assert_equal(p.stats().hits_,3U);
+  }
+  // larger than largest class, not cached
+  auto const cached(p.stats().cached_);
+  {
+    auto x(p.lease(((size_t)2<<BufferPool::MAX_CLASS)+1));
+    xju::assert_equal(x.data().capacity(),((size_t)2<<BufferPool::MAX_CLASS)+1);
+  }
+  xju::assert_equal(p.stats().cached_,cached);
+  p.trim();
+  xju::assert_equal(p.stats().cached_,0U);
+}
+
+// cap
+void test2() {
+  BufferPool p(1024);
+  {
+    auto x(p.lease(512));
+    auto y(p.lease(256));
+  }
+  xju::assert_equal(p.stats().cached_,768U);
+  {
+    // frees cached buffers to make room
+    auto x(p.lease(1024));
+    xju::assert_equal(p.stats().cached_,0U);
+    try{
+      p.lease(1);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"lease 1-byte buffer from pool with 1024 bytes leased would exceed its 1024-byte cap.");
+    }
+    xju::assert_equal(p.stats().refusals_,1U);
+  }
+  xju::assert_equal(p.stats().cached_,1024U);
+  p.setCap(512);
+  xju::assert_equal(p.stats().cached_,0U);
+  {
+    auto x(p.lease(256));
+    // grown beyond cap: not cached on return
+    x.data().resize(2000);
+  }
+  xju::assert_equal(p.stats().cached_,0U);
+  xju::assert_equal(p.stats().leased_,0U);
+}
+
+// thread local pool, MemOBuf/MemIBuf use
+void test3() {
+  BufferPool& p(BufferPool::threadLocal());
+  xju::assert_equal(&p,&BufferPool::threadLocal());
+  auto const s1(p.stats());
+  for(int i=0; i!=3; ++i){
+    xju::MemOBuf b(1024);
+    {
+      xju::net::ostream s(b);
+      s.put32(i);
+    }
+    xju::MemIBuf c(b.data().first,b.data().second);
+    xju::net::istream s(c);
+    xju::assert_equal(s.get32(),(uint32_t)i);
+  }
+  auto const s2(p.stats());
+  xju::assert_equal(s2.misses_-s1.misses_,2U);
+  xju::assert_equal(s2.hits_-s1.hits_,4U);
+
+  BufferPool* q(0);
+  BufferPool::Lease x;
+  std::thread t([&](){
+      q=&BufferPool::threadLocal();
+      x=q->lease(10);
+    });
+  t.join();
+  xju::assert_not_equal(q,&p);
+  // x returned to its thread's (orphaned) pool, which is then deleted
+  x=BufferPool::Lease();
+}
+
+// cross-thread use of threadLocal() pools, MemOBuf growth within cap,
+// cache cap
+void test4() {
+  BufferPool& p(BufferPool::threadLocal());
+  p.trim();
+  {
+    // lease of another (running) thread's pool destroyed here is
+    // freed, not cached
+    BufferPool* q(0);
+    BufferPool::Lease x;
+    bool leased(false);
+    bool done(false);
+    std::mutex m;
+    std::condition_variable c;
+    std::thread t([&](){
+        std::unique_lock<std::mutex> l(m);
+        q=&BufferPool::threadLocal();
+        xju::assert_equal(&q->local(),q);
+        x=q->lease(10);
+        leased=true;
+        c.notify_one();
+        c.wait(l,[&](){ return done; });
+        xju::assert_equal(q->stats().leased_,0U);
+        xju::assert_equal(q->stats().cached_,0U);
+      });
+    {
+      std::unique_lock<std::mutex> l(m);
+      c.wait(l,[&](){ return leased; });
+    }
+    xju::assert_equal(&q->local(),&p);
+    // copy leases from this thread's pool
+    auto const leases(p.stats().hits_+p.stats().misses_);
+    BufferPool::Lease y(x);
+    xju::assert_equal(p.stats().hits_+p.stats().misses_,leases+1);
+    x=BufferPool::Lease();
+    {
+      std::unique_lock<std::mutex> l(m);
+      done=true;
+    }
+    c.notify_one();
+    t.join();
+  }
+  {
+    // MemOBuf growth is leased, so counts against (and is refused
+    // beyond) cap
+    BufferPool q(1024);
+    xju::MemOBuf b(256,std::numeric_limits<size_t>::max(),q);
+    try{
+      xju::net::ostream s(b);
+      for(int i=0; i!=64; ++i){
+        s.put32(i);
+      }
+      xju::assert_equal(q.stats().leased_,256U);
+      for(int i=64; i!=128; ++i){
+        s.put32(i);
+      }
+      xju::assert_equal(q.stats().leased_,512U);
+      // growing to 1024 bytes needs 512+1024 bytes while copying
+      s.put32(128);
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      xju::assert_equal(readableRepr(e),"lease 1024-byte buffer from pool with 512 bytes leased would exceed its 1024-byte cap.");
+    }
+    xju::assert_less_equal(q.stats().highWater_,1024U);
+    auto const d(b.data());
+    xju::MemIBuf c(d.first,d.second);
+    xju::net::istream t(c);
+    for(int i=0; i!=128; ++i){
+      xju::assert_equal(t.get32(),(uint32_t)i);
+    }
+  }
+  {
+    // threadLocal() pool caches at most THREAD_LOCAL_CACHE_CAP bytes
+    p.trim();
+    std::vector<BufferPool::Lease> x;
+    for(int i=0; i!=8; ++i){
+      x.push_back(p.lease((size_t)1<<BufferPool::MAX_CLASS));
+    }
+    x.clear();
+    xju::assert_equal(p.stats().cached_,
+                      (size_t)BufferPool::THREAD_LOCAL_CACHE_CAP);
+    p.setCacheCap(0);
+    xju::assert_equal(p.stats().cached_,0U);
+    p.setCacheCap(BufferPool::THREAD_LOCAL_CACHE_CAP);
+  }
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -187,6 +187,38 @@ void test4()
     assert_equal(e.what(), readableRepr(e));
 }
 
+// lazy context
+void test5()
+{
+    Exception e("cause", xju::Traced("FA", 100U));
+    int const n(3);
+    e.addLazyContext([n](std::ostream& s){ s << "read " << n << " bytes"; },
+                     {"FB",8});
+    e.addContext("c2", xju::Traced("FC", 9U));
+    e.addLazyContext([](std::ostream& s){ s << "c3"; },{"FD",10});
+    assert_equal(e.what(),
+                 std::string("Failed to c3 because\n"
+                             "failed to c2 because\n"
+                             "failed to read 3 bytes because\n"
+                             "cause."));
+    e.addLazyContext([](std::ostream& s){ s << "c4"; },{"FE",11});
+    assert_equal(e.context().size(), 4U);
+    assert_equal(e.context()[0].first, std::string("read 3 bytes"));
+    assert_equal(e.context()[0].second, xju::Traced("FB", 8U));
+    assert_equal(e.context()[2].first, std::string("c3"));
+    assert_equal(e.context()[3].first, std::string("c4"));
+    assert_equal(e.context()[3].second, xju::Traced("FE", 11U));
+
+    Exception e2("cause", xju::Traced("FA", 100U));
+    e2.addLazyContext([n](std::ostream& s){ s << "read " << n << " bytes"; },
+                      {"FB",8});
+    Exception e3("cause", xju::Traced("FA", 100U));
+    e3.addContext("read 3 bytes", xju::Traced("FB", 8U));
+    assert_equal(e2, e3);
+    Exception const e4(e2);
+    assert_equal(e4, e3);
+}
+
 //
 // failure
 //    (none)
@@ -200,6 +232,7 @@ int main(int argc, char* argv[])
     test2(); ++n;
     test3(); ++n;
     test4(); ++n;
+    test5(); ++n;
      
     std::cout << "PASS - " << n << " steps" << std::endl;
     return 0;
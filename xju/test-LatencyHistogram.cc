@@ -0,0 +1,96 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/LatencyHistogram.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/format.hh>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace xju
+{
+
+using std::chrono::nanoseconds;
+
+// small values exact, summary stats
+void test1() {
+  LatencyHistogram x;
+  xju::assert_equal(x.count(),0U);
+  xju::assert_equal(xju::format::str(x),"0 values");
+  for(int i=1; i!=101; ++i){
+    x.record(nanoseconds(i));
+  }
+  x.record(nanoseconds(-5));
+  xju::assert_equal(x.count(),101U);
+  xju::assert_equal(x.min(),nanoseconds(0));
+  xju::assert_equal(x.max(),nanoseconds(100));
+  xju::assert_equal(x.mean(),nanoseconds(50));
+  xju::assert_equal(x.percentile(0),nanoseconds(0));
+  xju::assert_equal(x.percentile(50),nanoseconds(50));
+  xju::assert_equal(x.percentile(99),nanoseconds(99));
+  xju::assert_equal(x.percentile(100),nanoseconds(100));
+  x.clear();
+  xju::assert_equal(x.count(),0U);
+  x.record(std::chrono::microseconds(12));
+  xju::assert_equal(xju::format::str(x),"1 values: min 0.000012s, 50% 0.000012s, 90% 0.000012s, 99% 0.000012s, 99.9% 0.000012s, max 0.000012s, mean 0.000012s");
+}
+
+// percentiles of large values within bucket precision, merge
+void test2() {
+  std::mt19937_64 r(7);
+  std::lognormal_distribution<double> d(12.0,2.0);
+  std::vector<int64_t> v;
+  LatencyHistogram a;
+  LatencyHistogram b;
+  for(int i=0; i!=100000; ++i){
+    int64_t const x(d(r));
+    v.push_back(x);
+    ((i%2)?a:b).record(nanoseconds(x));
+  }
+  a.merge(b);
+  std::sort(v.begin(),v.end());
+  xju::assert_equal(a.count(),v.size());
+  xju::assert_equal(a.min(),nanoseconds(v.front()));
+  xju::assert_equal(a.max(),nanoseconds(v.back()));
+  for(double p: {1.0,25.0,50.0,90.0,99.0,99.9,99.99}){
+    int64_t const exact(v[(size_t)std::ceil(p/100.0*v.size())-1]);
+    int64_t const y(a.percentile(p).count());
+    xju::assert_greater_equal(y,exact);
+    xju::assert_less_equal(y-exact,exact/128);
+  }
+  xju::assert_equal(a.percentile(100),nanoseconds(v.back()));
+
+  // extremes
+  LatencyHistogram c;
+  c.record(nanoseconds(std::numeric_limits<int64_t>::max()));
+  c.record(nanoseconds(128));
+  c.record(nanoseconds(255));
+  c.record(nanoseconds(256));
+  xju::assert_equal(c.percentile(25),nanoseconds(128));
+  xju::assert_equal(c.percentile(50),nanoseconds(255));
+  xju::assert_equal(c.percentile(75),nanoseconds(257));
+  xju::assert_equal(c.percentile(100),
+                    nanoseconds(std::numeric_limits<int64_t>::max()));
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
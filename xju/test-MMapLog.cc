@@ -0,0 +1,217 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/MMapLog.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/file/rm.hh>
+#include <xju/file/rename.hh>
+#include <xju/file/write.hh>
+#include <xju/file/Mode.hh>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+namespace xju
+{
+
+struct Node
+{
+  uint64_t id_;
+  uint32_t parent_;
+  char name_[12];
+};
+
+Node node(uint64_t id) {
+  Node result;
+  result.id_=id;
+  result.parent_=id/2;
+  std::string const name("n"+std::to_string(id));
+  ::strncpy(result.name_,name.c_str(),sizeof(result.name_));
+  return result;
+}
+
+void rm(std::pair<xju::path::AbsolutePath,xju::path::FileName> const& f) {
+  try{
+    xju::file::rm(f);
+  }
+  catch(xju::Exception const&){
+  }
+}
+
+// append, iterate, grow (with remap), reopen
+void test1() {
+  auto const f(xju::path::split("test-MMapLog.log"));
+  rm(f);
+  size_t const N(5000);
+  {
+    // small grow and reserve to force growth and remap
+    MMapLog x(f,false,MADV_SEQUENTIAL,1,4096);
+    xju::assert_equal(x.crashed(),false);
+    xju::assert_equal(x.begin(),x.end());
+    std::vector<MMapLog::RecordId> ids;
+    for(size_t i=0; i!=N; ++i){
+      ids.push_back(x.append(node(i)));
+      if (i%100==0){
+        std::string const s("string record "+std::to_string(i));
+        x.append(s.data(),s.size());
+      }
+    }
+    for(size_t i=0; i!=N; ++i){
+      Node const& n(x.get<Node>(ids[i]));
+      xju::assert_equal(n.id_,i);
+      xju::assert_equal(std::string(n.name_),"n"+std::to_string(i));
+    }
+    xju::assert_equal(x.committed(),x.begin());
+    x.commit();
+    xju::assert_equal(x.committed(),x.end());
+  }
+  {
+    MMapLog x(f,true);
+    xju::assert_equal(x.crashed(),false);
+    size_t nodes(0);
+    size_t strings(0);
+    for(auto i=x.begin(); i!=x.end(); i=x.next(i)){
+      auto const r(x.get(i));
+      if (r.second==sizeof(Node)){
+        xju::assert_equal(x.get<Node>(i).id_,nodes);
+        ++nodes;
+      }
+      else{
+        xju::assert_equal(
+          std::string((char const*)r.first,r.second),
+          "string record "+std::to_string(strings*100));
+        ++strings;
+      }
+    }
+    xju::assert_equal(nodes,N);
+    xju::assert_equal(strings,N/100);
+    // empty record
+    auto const e(x.append("",0));
+    xju::assert_equal(x.get(e).second,0U);
+    xju::assert_equal(x.next(e),x.end());
+  }
+  rm(f);
+}
+
+// crash recovery: uncommitted records discarded
+void test2() {
+  auto const f(xju::path::split("test-MMapLog.log"));
+  rm(f);
+  pid_t const pid(::fork());
+  if (pid==0){
+    MMapLog x(f);
+    x.append(node(1));
+    x.append(node(2));
+    x.commit();
+    x.append(node(3));
+    // crash
+    ::_exit(0);
+  }
+  int status;
+  xju::assert_equal(::waitpid(pid,&status,0),pid);
+  xju::assert_equal(WIFEXITED(status),true);
+  {
+    MMapLog x(f);
+    xju::assert_equal(x.crashed(),true);
+    std::vector<uint64_t> ids;
+    for(auto i=x.begin(); i!=x.end(); i=x.next(i)){
+      ids.push_back(x.get<Node>(i).id_);
+    }
+    xju::assert_equal(ids,std::vector<uint64_t>({1,2}));
+    x.append(node(4));
+  }
+  {
+    // previous closed cleanly, having committed on close
+    MMapLog x(f);
+    xju::assert_equal(x.crashed(),false);
+    std::vector<uint64_t> ids;
+    for(auto i=x.begin(); i!=x.end(); i=x.next(i)){
+      ids.push_back(x.get<Node>(i).id_);
+    }
+    xju::assert_equal(ids,std::vector<uint64_t>({1,2,4}));
+  }
+  rm(f);
+}
+
+// not a log
+void test3() {
+  auto const f(xju::path::split("test-MMapLog.log"));
+  rm(f);
+  xju::file::write(f,"fred",4,xju::file::Mode(0666));
+  try{
+    MMapLog x(f);
+    xju::assert_never_reached();
+  }
+  catch(xju::Exception const& e){
+    xju::assert_equal(readableRepr(e),"Failed to open memory-mapped log file "+xju::path::str(f)+" because\nfile size 4 is not valid for an xju::MMapLog.");
+  }
+  rm(f);
+}
+
+// remap fails (file renamed away, so it cannot be opened to map it)
+void test4() {
+  auto const f(xju::path::split("test-MMapLog.log"));
+  auto const g(xju::path::split("test-MMapLog.log.moved"));
+  rm(f);
+  rm(g);
+  std::vector<MMapLog::RecordId> ids;
+  {
+    MMapLog x(f,false,MADV_NORMAL,1,4096);
+    ids.push_back(x.append(node(1)));
+    xju::file::rename(f,g);
+    try{
+      for(uint64_t i=2; i!=1000; ++i){
+        ids.push_back(x.append(node(i)));
+      }
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      // log still usable with existing mapping
+      auto const r(x.get(ids.back()));
+      xju::assert_equal(r.second,sizeof(Node));
+      xju::assert_equal(((Node const*)r.first)->id_,ids.size());
+    }
+    xju::file::rename(g,f);
+    // can grow again once file can be mapped
+    for(uint64_t i=ids.size()+1; i!=1000; ++i){
+      ids.push_back(x.append(node(i)));
+    }
+    x.commit();
+  }
+  {
+    MMapLog x(f);
+    xju::assert_equal(x.crashed(),false);
+    uint64_t i(0);
+    for(auto j(x.begin()); j!=x.end(); j=x.next(j), ++i){
+      xju::assert_equal(j,ids[i]);
+      xju::assert_equal(((Node const*)x.get(j).first)->id_,i+1);
+    }
+    xju::assert_equal(i,999U);
+  }
+  rm(f);
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/SegmentOBuf.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/net/ostream.hh>
+#include <string>
+#include <vector>
+
+namespace xju
+{
+
+std::string gather(SegmentOBuf const& b)
+{
+  std::string result;
+  for(auto const& x: b.segments()){
+    result+=std::string((char const*)x.iov_base,x.iov_len);
+  }
+  xju::assert_equal(result.size(),b.size());
+  return result;
+}
+
+// owned, borrowed and given segments
+void test1() {
+  SegmentOBuf b(4);
+  xju::assert_equal(b.size(),0U);
+  std::string const body("body");
+  {
+    xju::net::ostream s(b);
+    s.put(std::string("head"));
+    s.put8('e');
+  }
+  b.borrow(body.data(),body.size());
+  {
+    xju::net::ostream s(b);
+    s.put(std::string("tail"));
+  }
+  b.give(std::vector<uint8_t>({'x','y'}));
+  b.borrow(body.data(),0);
+  xju::assert_equal(gather(b),std::string("headebodytailxy"));
+  // "head" "e" are in different chunks; "tail" spans 2 chunks
+  xju::assert_equal(b.segments().size(),6U);
+  xju::assert_equal(b.segments()[2].iov_base,(void*)body.data());
+
+  b.clear();
+  xju::assert_equal(b.size(),0U);
+  xju::assert_equal(b.segments().size(),0U);
+  {
+    xju::net::ostream s(b);
+    s.put(std::string("ab"));
+  }
+  {
+    xju::net::ostream s(b);
+    s.put(std::string("cd"));
+  }
+  // contiguous owned bytes form one segment
+  xju::assert_equal(gather(b),std::string("abcd"));
+  xju::assert_equal(b.segments().size(),1U);
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
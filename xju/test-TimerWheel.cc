@@ -0,0 +1,259 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/TimerWheel.hh>
+
+#include <iostream>
+#include <xju/assert.hh>
+#include <xju/steadyEternity.hh>
+#include <xju/Exception.hh>
+#include <memory>
+#include <vector>
+#include <map>
+#include <random>
+
+namespace xju
+{
+
+typedef std::chrono::steady_clock::time_point T;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+// schedule, expire, cancel, reschedule, nextDeadline
+void test1() {
+  T const t0(xju::steadyNow());
+  TimerWheel w(milliseconds(1),t0);
+  xju::assert_equal(w.nextDeadline(),xju::steadyEternity());
+  xju::assert_equal(w.expire(t0+milliseconds(10)),0U);
+
+  std::vector<std::string> calls;
+  TimerWheel::Timer a(w,[&](){ calls.push_back("a"); });
+  TimerWheel::Timer b(w,[&](){ calls.push_back("b"); });
+  TimerWheel::Timer c(w,[&](){ calls.push_back("c"); });
+  xju::assert_equal(a.scheduled(),false);
+
+  a.schedule(t0+milliseconds(20));
+  b.schedule(t0+milliseconds(30));
+  c.schedule(t0+milliseconds(5000));
+  xju::assert_equal(a.scheduled(),true);
+  xju::assert_equal(a.deadline(),t0+milliseconds(20));
+  xju::assert_equal(w.size(),3U);
+  xju::assert_equal(w.nextDeadline(),t0+milliseconds(20));
+
+  xju::assert_equal(w.expire(t0+milliseconds(19)),0U);
+  xju::assert_equal(w.expire(t0+milliseconds(20)),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"a"}));
+  xju::assert_equal(a.scheduled(),false);
+  xju::assert_equal(w.size(),2U);
+  xju::assert_equal(w.nextDeadline(),t0+milliseconds(30));
+
+  b.cancel();
+  xju::assert_equal(b.scheduled(),false);
+  xju::assert_equal(w.size(),1U);
+  // c is not yet located precisely
+  xju::assert_less_equal(w.nextDeadline(),t0+milliseconds(5000));
+  xju::assert_equal(w.expire(t0+milliseconds(4000)),0U);
+  c.schedule(t0+milliseconds(4500));
+  xju::assert_equal(w.expire(t0+milliseconds(4499)),0U);
+  xju::assert_equal(w.nextDeadline(),t0+milliseconds(4500));
+  xju::assert_equal(w.expire(t0+milliseconds(6000)),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"a","c"}));
+  xju::assert_equal(w.nextDeadline(),xju::steadyEternity());
+
+  // deadline in the past, deadline rounded up to resolution
+  a.schedule(t0);
+  xju::assert_less_equal(w.nextDeadline(),t0+milliseconds(6000));
+  b.schedule(t0+milliseconds(6001)+nanoseconds(1));
+  xju::assert_equal(w.expire(t0+milliseconds(6001)+nanoseconds(1)),1U);
+  xju::assert_equal(w.nextDeadline(),t0+milliseconds(6002));
+  xju::assert_equal(w.expire(t0+milliseconds(6002)),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"a","c","a","b"}));
+
+  // eternity
+  a.schedule(xju::steadyEternity());
+  xju::assert_equal(w.expire(t0+std::chrono::hours(24*365)),0U);
+  a.cancel();
+  xju::assert_equal(w.size(),0U);
+}
+
+// compare against a reference, over a range of deadlines that exercises
+// all levels and overflow
+void test2() {
+  T const t0(xju::steadyNow());
+  TimerWheel w(nanoseconds(1),t0);
+  std::mt19937_64 g(1);
+  size_t const N(20000);
+  std::vector<std::unique_ptr<TimerWheel::Timer> > timers;
+  std::map<size_t,T> expected;  // by timer
+  std::vector<size_t> fired;
+  for(size_t i=0; i!=N; ++i){
+    timers.push_back(std::unique_ptr<TimerWheel::Timer>(
+                       new TimerWheel::Timer(w,[&fired,i](){
+                           fired.push_back(i);
+                         })));
+  }
+  T now(t0);
+  auto randomDeadline([&](){
+      // spread over ~2^40ns
+      unsigned int const bits(g()%41);
+      return now+nanoseconds(g()&(((uint64_t)1<<bits)-1));
+    });
+  for(size_t i=0; i!=N; ++i){
+    T const d(randomDeadline());
+    timers[i]->schedule(d);
+    expected[i]=d;
+  }
+  for(int round=0; round!=2000; ++round){
+    auto const next(w.nextDeadline());
+    // advance by random amount, sometimes exactly to nextDeadline
+    if (g()%2){
+      now=std::max(now,next);
+    }
+    else{
+      now+=nanoseconds(g()&(((uint64_t)1<<(g()%38))-1));
+    }
+    fired.clear();
+    size_t const n(w.expire(now));
+    xju::assert_equal(n,fired.size());
+    std::set<size_t> f(fired.begin(),fired.end());
+    xju::assert_equal(f.size(),fired.size());
+    for(auto i=expected.begin(); i!=expected.end();){
+      if ((*i).second<=now){
+        xju::assert_equal(f.erase((*i).first),1U);
+        xju::assert_equal(timers[(*i).first]->scheduled(),false);
+        i=expected.erase(i);
+      }
+      else{
+        xju::assert_equal(timers[(*i).first]->scheduled(),true);
+        xju::assert_greater_equal((*i).second,w.nextDeadline());
+        ++i;
+      }
+    }
+    xju::assert_equal(f.size(),0U);
+    xju::assert_equal(w.size(),expected.size());
+    // cancel some, reschedule some
+    for(int j=0; j!=10; ++j){
+      size_t const i(g()%N);
+      if (g()%2){
+        timers[i]->cancel();
+        expected.erase(i);
+      }
+      else{
+        T const d(randomDeadline());
+        timers[i]->schedule(d);
+        expected[i]=d;
+      }
+    }
+  }
+  timers.clear();
+  xju::assert_equal(w.size(),0U);
+}
+
+// handler cancels, destroys and reschedules timers; handler exception
+void test3() {
+  T const t0(xju::steadyNow());
+  TimerWheel w(milliseconds(1),t0);
+  std::vector<std::string> calls;
+  std::unique_ptr<TimerWheel::Timer> a;
+  std::unique_ptr<TimerWheel::Timer> b;
+  std::unique_ptr<TimerWheel::Timer> c;
+  a.reset(new TimerWheel::Timer(w,[&](){
+        calls.push_back("a");
+        b.reset();
+        c->cancel();
+        a.reset();
+      }));
+  b.reset(new TimerWheel::Timer(w,[&](){
+        calls.push_back("b");
+        a.reset();
+        c->cancel();
+        b.reset();
+      }));
+  c.reset(new TimerWheel::Timer(w,[&](){
+        calls.push_back("c");
+        c->schedule(t0+milliseconds(2));
+      }));
+  a->schedule(t0+milliseconds(1));
+  b->schedule(t0+milliseconds(1));
+  c->schedule(t0+milliseconds(1));
+  xju::assert_equal(w.expire(t0+milliseconds(1)),1U);
+  xju::assert_equal(w.size(),0U);
+  xju::assert_equal(calls.size(),1U);
+  calls.clear();
+
+  // reschedule self for now: expires on next expire()
+  c->schedule(t0+milliseconds(1));
+  xju::assert_equal(w.expire(t0+milliseconds(2)),1U);
+  xju::assert_equal(w.expire(t0+milliseconds(2)),1U);
+  xju::assert_equal(calls,std::vector<std::string>({"c","c"}));
+  c->cancel();
+
+  TimerWheel::Timer d(w,[&](){
+      calls.push_back("d");
+      throw xju::Exception("d failed",XJU_TRACED);
+    });
+  TimerWheel::Timer e(w,[&](){
+      calls.push_back("e");
+      throw xju::Exception("e failed",XJU_TRACED);
+    });
+  d.schedule(t0+milliseconds(3));
+  e.schedule(t0+milliseconds(3));
+  calls.clear();
+  std::set<std::string> failed;
+  for(int i=0; i!=2; ++i){
+    try{
+      w.expire(t0+milliseconds(3));
+      xju::assert_never_reached();
+    }
+    catch(xju::Exception const& e){
+      failed.insert(e.cause().first);
+    }
+  }
+  xju::assert_equal(failed,std::set<std::string>({"d failed","e failed"}));
+  xju::assert_equal(w.expire(t0+milliseconds(3)),0U);
+  xju::assert_equal(calls.size(),2U);
+}
+
+// many timers
+void test4() {
+  T const t0(xju::steadyNow());
+  TimerWheel w(milliseconds(1),t0);
+  size_t const N(200000);
+  size_t fired(0);
+  std::vector<std::unique_ptr<TimerWheel::Timer> > timers;
+  timers.reserve(N);
+  for(size_t i=0; i!=N; ++i){
+    timers.push_back(std::unique_ptr<TimerWheel::Timer>(
+                       new TimerWheel::Timer(w,[&](){ ++fired; })));
+    timers.back()->schedule(t0+milliseconds(i%10000));
+  }
+  xju::assert_equal(w.size(),N);
+  T now(t0);
+  while(w.size()){
+    now=std::max(now,w.nextDeadline());
+    w.expire(now);
+  }
+  xju::assert_equal(fired,N);
+  xju::assert_equal(now,t0+milliseconds(9999));
+}
+
+}
+
+using namespace xju;
+
+int main(int argc, char* argv[])
+{
+  unsigned int n(0);
+  test1(), ++n;
+  test2(), ++n;
+  test3(), ++n;
+  test4(), ++n;
+  std::cout << "PASS - " << n << " steps" << std::endl;
+  return 0;
+}
@@ -13,6 +13,9 @@
 #include <iostream>
 #include <xju/assert.hh>
 #include "xju/Thread.hh"
+#include <xju/steadyNow.hh>
+#include <xju/DeadlineReached.hh>
+#include <sys/uio.h>
 
 namespace xju
 {
@@ -240,6 +243,71 @@ void test2() noexcept
 
 }
 
+// writev/readv
+void test3() {
+  auto p(xju::pipe(true,true));
+  std::string const a("fred");
+  std::string const b("");
+  std::string const c("jock and jill");
+  std::vector<iovec> const w({
+      {(void*)a.data(),a.size()},
+      {(void*)b.data(),b.size()},
+      {(void*)c.data(),c.size()}});
+  xju::assert_equal(p.second->writev(w.data(),w.size(),xju::steadyNow()),17U);
+
+  std::vector<char> r1(3,0);
+  std::vector<char> r2(0,0);
+  std::vector<char> r3(20,0);
+  std::vector<iovec> const r({
+      {r1.data(),r1.size()},
+      {r2.data(),r2.size()},
+      {r3.data(),r3.size()}});
+  xju::assert_equal(p.first->readv(r.data(),r.size(),xju::steadyNow()),17U);
+  xju::assert_equal(std::string(r1.begin(),r1.end()),std::string("fre"));
+  xju::assert_equal(std::string(r3.begin(),r3.begin()+14),
+                    std::string("djock and jill"));
+
+  // partial writes, resuming within a buffer
+  size_t const pipeMax(fillPipe(*p.second));
+  std::vector<uint8_t> big(pipeMax,'x');
+  std::vector<iovec> const w2({
+      {(void*)a.data(),a.size()},
+      {big.data(),big.size()},
+      {(void*)c.data(),c.size()}});
+  {
+    xju::Thread t([&](){
+        std::vector<uint8_t> x(2*pipeMax+17,0);
+        iovec const v{x.data(),x.size()};
+        p.first->readvAll(&v,1,xju::steadyNow()+std::chrono::seconds(5));
+        xju::assert_equal(std::string(x.begin()+pipeMax,
+                                      x.begin()+pipeMax+4),a);
+        xju::assert_equal(std::string(x.end()-13,x.end()),c);
+      });
+    p.second->writevAll(w2.data(),w2.size(),
+                        xju::steadyNow()+std::chrono::seconds(5));
+  }
+  // deadline
+  fillPipe(*p.second);
+  try{
+    p.second->writevAll(w2.data(),w2.size(),
+                        xju::steadyNow()+std::chrono::milliseconds(50));
+    xju::assert_never_reached();
+  }
+  catch(xju::DeadlineReached const&){
+  }
+  try{
+    std::vector<char> x(1,0);
+    iovec const v{x.data(),x.size()};
+    p.first->readvAll(&v,1,xju::steadyNow());
+    p.second.reset();
+    while(true){
+      p.first->readvAll(&v,1,xju::steadyNow());
+    }
+  }
+  catch(xju::io::Input::Closed const&){
+  }
+}
+
 }
 }
 
@@ -250,6 +318,7 @@ int main(int argc, char* argv[])
   unsigned int n(0);
   test1(), ++n;
   test2(), ++n;
+  test3(), ++n;
   std::cout << "PASS - " << n << " steps" << std::endl;
   return 0;
 }
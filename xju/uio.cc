@@ -0,0 +1,18 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#include <xju/uio.hh>
+
+namespace xju
+{
+const SyscallF3<ssize_t,int,const struct iovec*,int> readv={
+  "::readv",::readv};
+const SyscallF3<ssize_t,int,const struct iovec*,int> writev={
+  "::writev",::writev};
+}
@@ -0,0 +1,21 @@
+// Copyright (c) 2026 Trevor Taylor
+//
+// Permission to use, copy, modify, distribute and sell this software
+// and its documentation for any purpose is hereby granted without fee,
+// provided that the above copyright notice appear in all.
+// Trevor Taylor makes no representations about the suitability of this
+// software for any purpose.  It is provided "as is" without express or
+// implied warranty.
+//
+#ifndef _XJU_UIO_HH
+#define _XJU_UIO_HH
+
+#include "xju/syscall.hh"
+#include <sys/uio.h>
+
+namespace xju
+{
+extern const xju::SyscallF3<ssize_t,int,const struct iovec*,int> readv;
+extern const xju::SyscallF3<ssize_t,int,const struct iovec*,int> writev;
+}
+#endif
@@ -44,6 +44,9 @@ namespace xju
     const SyscallF1<int, int> fsync={
 	"fsync",
 	::fsync};
+    const SyscallF1<int, int> fdatasync={
+	"fdatasync",
+	::fdatasync};
 
     const SyscallF3<off_t, int, off_t, int> lseek={
 	"lseek",
@@ -421,7 +421,7 @@ void test12()
     xju::assert_equal(
       hcp_ast::reconstruct(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r)),
       s);
-    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({1,2,3,4,5,6,7,8,0,0,0,0,0,0,0,0}));
+    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({0x12,0x34,0x56,0x78,0,0,0,0,0,0,0,0,0,0,0,0}));
                                                                                                       
   }
   {
@@ -430,7 +430,7 @@ void test12()
     xju::assert_equal(
       hcp_ast::reconstruct(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r)),
       s);
-    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({1,2,3,4,5,6,7,8,0,0,0,0,4,3,2,1}));
+    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({0x12,0x34,0x56,0x78,0,0,0,0,0,0,0,0,0,0,0x43,0x21}));
                                                                                                       
   }
   {
@@ -439,7 +439,7 @@ void test12()
     xju::assert_equal(
       hcp_ast::reconstruct(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r)),
       s);
-    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({1,0,0,0,0,0,0,0,0,0,0,0,3,5,18,2}));
+    xju::assert_equal(hcp_ast::findOnlyChildOfType<IpV6AddressItem>(r).address_,xju::ip::v6::Address({0,1,0,0,0,0,0,0,0,0,0,0,3,5,18,2}));
                                                                                }
   try
   {